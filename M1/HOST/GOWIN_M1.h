@@ -0,0 +1,42 @@
+#ifndef __GOWIN_M1_HOST_H__
+#define __GOWIN_M1_HOST_H__
+
+// ============================================================================
+//  (Linux)õ GOWIN_M1.h 
+//  ֻṩ M1/USER ʾشͺں˺, κ.
+//  LCD ߷ MCU_LCD.h е LCD_HOST_MODEL ֧ת nt35510_model.c
+// ============================================================================
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define __IO volatile
+
+// AHB1  LCD Ļַ (²ᱻ)
+#define AHB_M1 0
+
+// Cortex-M ں˺
+#define __nop()             ((void)0)
+#define __NOP()             ((void)0)
+#define __DSB()             ((void)0)
+#define __ISB()             ((void)0)
+#define __WFI()             ((void)0)
+#define __disable_irq()     ((void)0)
+#define __enable_irq()      ((void)0)
+#define __get_PRIMASK()     (0U)
+
+// SysTick : ɲԳֱüֵ
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+extern SysTick_Type host_systick;
+extern uint32_t SystemCoreClock;
+#define SysTick             (&host_systick)
+#define SysTick_Config(ticks) ((void)(host_systick.LOAD = (ticks) - 1, host_systick.VAL = 0))
+
+#endif /* __GOWIN_M1_HOST_H__ */
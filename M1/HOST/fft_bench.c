@@ -0,0 +1,174 @@
+// ============================================================================
+//  Q15 FFT  (scope_fft.c ̼ͬһԴ)
+//  1. : ˫ FFT (ͬ numpy.fft.fft,  n)  bin Ƚ,
+//     ͬһݼӴ Q15 , ֻ FFT 
+//  2. dB : Scope_FFT_Power_dB  10*log10 Ƚ
+//  3. ʱ:  (rdtsc) ͵/˷, ȽϸĶǰԿ
+//  ÷: ./fft_bench [-n ]
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "scope_fft.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t bench_cycles(void) { return __rdtsc(); }
+#else
+#include <time.h>
+static uint64_t bench_cycles(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+#endif
+
+// ˫Ȳο: ݹ 2 FFT, X[k] = sum x[i] * exp(-2j*pi*i*k/n)
+static void ref_fft(double complex *x, int n)
+{
+    double complex even[SCOPE_FFT_N / 2], odd[SCOPE_FFT_N / 2];
+    int k;
+
+    if (n == 1) return;
+    for (k = 0; k < n / 2; k++) {
+        even[k] = x[2 * k];
+        odd[k] = x[2 * k + 1];
+    }
+    ref_fft(even, n / 2);
+    ref_fft(odd, n / 2);
+    for (k = 0; k < n / 2; k++) {
+        double complex t = cexp(-2.0 * I * M_PI * k / n) * odd[k];
+        x[k] = even[k] + t;
+        x[k + n / 2] = even[k] - t;
+    }
+}
+
+// ź: 8 λ ADC  (Ԥͬ),  Q15 Ӵ
+typedef enum { SIG_SINE_FS, SIG_SINE_SMALL, SIG_TWO_TONE, SIG_SQUARE, SIG_NOISE } Signal;
+static const char *signal_names[] = { "sine full-scale", "sine -40dB", "two tones", "square", "noise" };
+
+static void make_input(int16_t *x, int log2n, Signal s, unsigned seed)
+{
+    int n = 1 << log2n, i;
+    srand(seed);
+    for (i = 0; i < n; i++) {
+        double v;
+        switch (s) {
+        case SIG_SINE_FS:    v = 127.0 * sin(2 * M_PI * 37.3 * i / n); break;
+        case SIG_SINE_SMALL: v = 1.27 * sin(2 * M_PI * 21.0 * i / n) + (rand() % 3 - 1) * 0.5; break;
+        case SIG_TWO_TONE:   v = 60.0 * sin(2 * M_PI * 10.0 * i / n) + 30.0 * sin(2 * M_PI * 55.5 * i / n); break;
+        case SIG_SQUARE:     v = ((i * 7 / (n / 8)) & 1) ? 100.0 : -100.0; break;
+        default:             v = (rand() % 255) - 127.0; break;
+        }
+        int code = (int)lround(128.0 + v);
+        if (code < 0) code = 0;
+        if (code > 255) code = 255;
+        x[i] = (int16_t)((code - 128) << 8);
+    }
+    Scope_FFT_Window(x, log2n);
+}
+
+//  (LSB), ͬʱ RMS ͷֵ bin  dB 
+static double check_accuracy(int log2n, Signal s, double *rms_out, double *peak_db_err)
+{
+    static int16_t re[SCOPE_FFT_N], im[SCOPE_FFT_N];
+    static double complex ref[SCOPE_FFT_N];
+    int n = 1 << log2n, k, peak = 1;
+    double max_err = 0, sum_sq = 0;
+
+    make_input(re, log2n, s, 1234);
+    memset(im, 0, sizeof(im));
+    for (k = 0; k < n; k++) ref[k] = re[k];
+
+    Scope_FFT_Q15(re, im, log2n);
+    ref_fft(ref, n);
+
+    for (k = 0; k < n; k++) {
+        double complex r = ref[k] / n;
+        double er = creal(r) - re[k], ei = cimag(r) - im[k];
+        double e = fmax(fabs(er), fabs(ei));
+        if (e > max_err) max_err = e;
+        sum_sq += er * er + ei * ei;
+        if (k > 0 && k < n / 2 && cabs(ref[k]) > cabs(ref[peak])) peak = k;
+    }
+    *rms_out = sqrt(sum_sq / (2 * n));
+
+    {
+        uint32_t p = (uint32_t)((int32_t)re[peak] * re[peak] + (int32_t)im[peak] * im[peak]);
+        double ref_db = 10.0 * log10(pow(cabs(ref[peak]) / n, 2)) - SCOPE_FFT_DB_FS / 10.0;
+        *peak_db_err = Scope_FFT_Power_dB(p) / 10.0 - ref_db;
+    }
+    return max_err;
+}
+
+// dB : ȫΧ 10*log10 
+static double check_db_table(void)
+{
+    double worst = 0;
+    uint32_t p;
+
+    for (p = 1; p < 0x80000000u; p = p + (p >> 7) + 1) {
+        double ref = 10.0 * log10((double)p) - SCOPE_FFT_DB_FS / 10.0;
+        double err = fabs(Scope_FFT_Power_dB(p) / 10.0 - ref);
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+static void bench_speed(int log2n, int iterations)
+{
+    static int16_t re[SCOPE_FFT_N], im[SCOPE_FFT_N], src[SCOPE_FFT_N];
+    int n = 1 << log2n, i;
+    uint64_t t0, t1;
+
+    make_input(src, log2n, SIG_TWO_TONE, 1);
+    t0 = bench_cycles();
+    for (i = 0; i < iterations; i++) {
+        memcpy(re, src, n * sizeof(int16_t));
+        memset(im, 0, n * sizeof(int16_t));
+        Scope_FFT_Q15(re, im, log2n);
+    }
+    t1 = bench_cycles();
+
+    printf("  %3d points: %8.0f host cycles/FFT, %4d butterflies, %5d multiplies\n",
+           n, (double)(t1 - t0) / iterations, (n / 2) * log2n, (n / 2) * log2n * 4);
+}
+
+int main(int argc, char **argv)
+{
+    int iterations = 20000, log2n, s, bad = 0;
+    double db_err;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) iterations = atoi(argv[2]);
+
+    printf("Q15 FFT accuracy vs double-precision reference (X[k]/n, Q15 LSB):\n");
+    printf("  %-16s %6s %8s %8s %10s\n", "signal", "points", "max", "rms", "peak dB");
+    for (log2n = SCOPE_FFT_LOG2N - 1; log2n <= SCOPE_FFT_LOG2N; log2n++) {
+        for (s = SIG_SINE_FS; s <= SIG_NOISE; s++) {
+            double rms, peak_err;
+            double max_err = check_accuracy(log2n, (Signal)s, &rms, &peak_err);
+            // 9 , ÿ 1 LSB; ֵ bin  dB Ҫ dB 
+            int ok = max_err <= 6.0 && rms <= 1.5 && fabs(peak_err) <= 0.25;
+            printf("  %-16s %6d %8.2f %8.3f %+10.3f %s\n", signal_names[s], 1 << log2n,
+                   max_err, rms, peak_err, ok ? "" : "<-- FAIL");
+            bad += !ok;
+        }
+    }
+
+    db_err = check_db_table();
+    // β 5 λ (0.07dB) + ָͽȡ 0.1dB ( 0.05dB)
+    printf("power -> dB table max error: %.3f dB %s\n", db_err, db_err <= 0.2 ? "" : "<-- FAIL");
+    bad += db_err > 0.2;
+
+    printf("speed (%d iterations):\n", iterations);
+    bench_speed(SCOPE_FFT_LOG2N - 1, iterations);
+    bench_speed(SCOPE_FFT_LOG2N, iterations);
+
+    printf("fft checks: %s\n", bad ? "MISMATCH" : "OK");
+    return bad ? 2 : 0;
+}
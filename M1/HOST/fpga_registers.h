@@ -0,0 +1,17 @@
+#ifndef __FPGA_REGISTERS_HOST_H__
+#define __FPGA_REGISTERS_HOST_H__
+
+// ============================================================================
+//  :  AHB2 ַռضһͨڴ,
+//  ĴȻʹ M1/USER/FPGA_Registers.h
+// ============================================================================
+
+#include <stdint.h>
+
+extern uint32_t host_fpga_space[0x1000 / 4];
+
+#define FPGA_PERIPH_BASE ((uintptr_t)host_fpga_space)
+
+#include "../USER/FPGA_Registers.h"
+
+#endif /* __FPGA_REGISTERS_HOST_H__ */
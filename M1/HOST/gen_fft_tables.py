@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+# ============================================================================
+#  生成 M1/USER/scope_fft_tables.c: 512 点 Q15 FFT 的旋转因子、位反转、
+#  Hann 窗和功率 -> dB 查找表. 表放在 flash (const), 固件运行时不做任何三角/对数运算.
+#  用法: python3 gen_fft_tables.py [输出文件]   (与 M1/USER 其余源码一样输出 GBK + CRLF)
+# ============================================================================
+import math
+import os
+import sys
+
+N = 512
+LOG2N = 9
+
+
+def q15(v):
+    return max(-32768, min(32767, int(round(v * 32768.0))))
+
+
+def bitrev(i, bits):
+    r = 0
+    for _ in range(bits):
+        r = (r << 1) | (i & 1)
+        i >>= 1
+    return r
+
+
+def rows(values, per_line=12):
+    out = []
+    for i in range(0, len(values), per_line):
+        out.append('    ' + ', '.join('%6d' % v for v in values[i:i + per_line]) + ',')
+    return '\n'.join(out)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    path = sys.argv[1] if len(sys.argv) > 1 else os.path.join(here, '..', 'USER', 'scope_fft_tables.c')
+
+    cos_t = [q15(math.cos(2 * math.pi * k / N)) for k in range(N // 2)]
+    sin_t = [q15(math.sin(2 * math.pi * k / N)) for k in range(N // 2)]
+    rev_t = [bitrev(i, LOG2N) for i in range(N)]
+    hann_t = [q15(0.5 - 0.5 * math.cos(2 * math.pi * i / N)) for i in range(N)]
+    # 10*log10(2^e) 与 10*log10(1 + (m + 0.5)/32), 单位 0.1dB
+    db_exp = [int(round(100 * math.log10(2.0) * e)) for e in range(32)]
+    db_mant = [int(round(100 * math.log10(1 + (m + 0.5) / 32.0))) for m in range(32)]
+
+    text = f"""// ============================================================================
+//  由 M1/HOST/gen_fft_tables.py 生成, 请勿手工修改.
+//  {N} 点 Q15 FFT 用表, 全部为 const, 链接到 flash.
+// ============================================================================
+#include "scope_fft.h"
+
+// cos(2*pi*k/N), k = 0..N/2-1
+const int16_t scope_fft_cos[SCOPE_FFT_N / 2] = {{
+{rows(cos_t)}
+}};
+
+// sin(2*pi*k/N), k = 0..N/2-1
+const int16_t scope_fft_sin[SCOPE_FFT_N / 2] = {{
+{rows(sin_t)}
+}};
+
+// {LOG2N} 位位反转; 点数为 N/2^s 时取 scope_fft_bitrev[i] >> s
+const uint16_t scope_fft_bitrev[SCOPE_FFT_N] = {{
+{rows(rev_t)}
+}};
+
+// Hann 窗 0.5 - 0.5*cos(2*pi*i/N); 点数为 N/2^s 时隔 2^s 取一个
+const int16_t scope_fft_hann[SCOPE_FFT_N] = {{
+{rows(hann_t)}
+}};
+
+// 功率 -> dB: 10*log10(p) = db_exp[最高位序号] + db_mant[最高位之后 5 位], 单位 0.1dB
+const int16_t scope_fft_db_exp[32] = {{
+{rows(db_exp)}
+}};
+
+const int16_t scope_fft_db_mant[32] = {{
+{rows(db_mant)}
+}};
+"""
+    with open(path, 'w', encoding='gbk', newline='\r\n') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,747 @@
+// ============================================================================
+//  LCD Ⱦ׼ ()
+//   NT35510 ģϻطҳ, ͳÿεõ߶дͺʱ.
+//  ÷: ./lcd_bench [-n ] [-o PPMĿ¼]
+// ============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+
+#include "main.h"
+#include "MCU_LCD.h"
+#include "fpga_registers.h"
+#include "event_handler.h"
+#include "ui_design_handler.h"
+#include "analog_input_features.h"
+#include "scope_trigger.h"
+#include "scope_measure.h"
+#include "scope_fft.h"
+#include "event_queue.h"
+#include "scheduler.h"
+#include "systime.h"
+#include "nt35510_model.h"
+
+// --- ̼ main.c / Touch.c ṩȫ ---
+uint32_t host_fpga_space[0x1000 / 4];
+volatile PageState_t currentPage = PAGE_MAIN;
+Touch_Data Touch_LCD;
+char display_str_buffer[64];
+SysTick_Type host_systick;
+uint32_t SystemCoreClock = 50000000;
+
+typedef struct
+{
+    const char *name;
+    void (*prepare)(void);  // ͳƵ׼
+    void (*run)(void);      // ƹ
+} Bench_Case_t;
+
+static uint8_t scope_frames[2][WAVEFORM_POINTS];
+static int scope_frame_index;
+
+// һ֡ 2.5 ڵҲ ( 128, Լ 1.2V @ 3.3V ), phase Ϊ()
+static void make_sine_frame(uint8_t *buf, int points, double phase)
+{
+    int i;
+
+    for (i = 0; i < points; i++)
+        buf[i] = (uint8_t)lround(128.0 + 95.0 * sin(2.0 * M_PI * (2.5 * i / points + phase / 360.0)));
+}
+
+static void prepare_main(void)   { nt35510_model_reset(LCD_BLACK); }
+static void run_main(void)       { Display_Main_board(); }
+
+static void prepare_analog(void) { nt35510_model_reset(LCD_BLACK); }
+static void run_analog(void)     { Display_Analog_in(); }
+
+// ʾҳʾ, ѻ 0 ֡
+static void prepare_scope(void)
+{
+    nt35510_model_reset(LCD_BLACK);
+    Display_Analog_in();
+    make_sine_frame(scope_frames[0], WAVEFORM_POINTS, 0.0);
+    make_sine_frame(scope_frames[1], WAVEFORM_POINTS, 40.0);
+    Draw_Scope_Waveform(scope_frames[0], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+    scope_frame_index = 1;
+}
+
+// ػ:  + 
+static void run_scope_full(void)
+{
+    Draw_Scope_Grid(Analog_WaveBoard);
+    Draw_Scope_Waveform(scope_frames[scope_frame_index], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+    scope_frame_index ^= 1;
+}
+
+// ɼʱһ֡: һ֡κ²
+static void run_scope_frame(void)
+{
+    Draw_Scope_Waveform(scope_frames[scope_frame_index], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+    scope_frame_index ^= 1;
+}
+
+// ֵȡ: 256  {min, max} , ÿ 8 , ë
+static uint8_t envelope_frames[2][WAVEFORM_POINTS];
+
+static void make_envelope_frame(uint8_t *pairs, int slots, double phase)
+{
+    int i, j;
+
+    for (i = 0; i < slots; i++)
+    {
+        int lo = 255, hi = 0;
+        for (j = 0; j < 8; j++)
+        {
+            int n = i * 8 + j;
+            int v = (int)lround(128.0 + 95.0 * sin(2.0 * M_PI * (2.5 * n / (slots * 8.0) + phase / 360.0)));
+            if ((n % 197) == 0)
+                v += 60;    // ȡʽ»©խ
+            if (v > 255) v = 255;
+            if (v < lo) lo = v;
+            if (v > hi) hi = v;
+        }
+        pairs[2 * i] = (uint8_t)lo;
+        pairs[2 * i + 1] = (uint8_t)hi;
+    }
+}
+
+static void prepare_envelope(void)
+{
+    nt35510_model_reset(LCD_BLACK);
+    Display_Analog_in();
+    make_envelope_frame(envelope_frames[0], WAVEFORM_POINTS / 2, 0.0);
+    make_envelope_frame(envelope_frames[1], WAVEFORM_POINTS / 2, 40.0);
+    Draw_Scope_Envelope(envelope_frames[0], WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+    scope_frame_index = 1;
+}
+
+static void run_scope_envelope(void)
+{
+    Draw_Scope_Envelope(envelope_frames[scope_frame_index], WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+    scope_frame_index ^= 1;
+}
+
+// ʽ: , ÿθ 16 ػ (̼Ĺˢͬ)
+#define ROLL_STEP 16
+static uint8_t roll_stream[WAVEFORM_POINTS * 8];
+static uint8_t roll_screen[WAVEFORM_POINTS];
+static int roll_pos;
+
+static void prepare_roll(void)
+{
+    prepare_scope();
+    make_sine_frame(roll_stream, sizeof(roll_stream), 0.0);
+    roll_pos = 0;
+    memcpy(roll_screen, roll_stream, WAVEFORM_POINTS);
+    Draw_Scope_Waveform(roll_screen, WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+}
+
+static void run_scope_roll(void)
+{
+    roll_pos += ROLL_STEP;
+    if (roll_pos + WAVEFORM_POINTS > (int)sizeof(roll_stream))
+        roll_pos = 0;
+    memmove(roll_screen, roll_screen + ROLL_STEP, WAVEFORM_POINTS - ROLL_STEP);
+    memcpy(roll_screen + WAVEFORM_POINTS - ROLL_STEP, roll_stream + roll_pos + WAVEFORM_POINTS - ROLL_STEP, ROLL_STEP);
+    Draw_Scope_Waveform(roll_screen, WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+}
+
+// Ƶ: ȡʽ 512  FFT õ 256  bin, ֡λͬ
+static int16_t spectrum_frames[2][SCOPE_FFT_N / 2];
+
+static void make_spectrum_frame(int16_t *db, const uint8_t *wave)
+{
+    static int16_t re[SCOPE_FFT_N], im[SCOPE_FFT_N];
+    int k;
+
+    for (k = 0; k < SCOPE_FFT_N; k++) {
+        re[k] = (int16_t)(((int32_t)wave[k] - 128) << 8);
+        im[k] = 0;
+    }
+    Scope_FFT_Window(re, SCOPE_FFT_LOG2N);
+    Scope_FFT_Q15(re, im, SCOPE_FFT_LOG2N);
+    for (k = 0; k < SCOPE_FFT_N / 2; k++)
+        db[k] = Scope_FFT_Power_dB((uint32_t)((int32_t)re[k] * re[k] + (int32_t)im[k] * im[k]));
+}
+
+// ʾҳʾ 0 ֡, ȻеƵͼ
+static void prepare_spectrum(void)
+{
+    prepare_scope();
+    make_spectrum_frame(spectrum_frames[0], scope_frames[0]);
+    make_spectrum_frame(spectrum_frames[1], scope_frames[1]);
+    Draw_Scope_Spectrum(spectrum_frames[0], SCOPE_FFT_N / 2, Analog_WaveBoard);
+    scope_frame_index = 1;
+}
+
+static void run_scope_spectrum(void)
+{
+    Draw_Scope_Spectrum(spectrum_frames[scope_frame_index], SCOPE_FFT_N / 2, Analog_WaveBoard);
+    scope_frame_index ^= 1;
+}
+
+// ˫ͨ: 256  {CH1, CH2} ֽڶ, CH2 ΪƵʡȲͬ,  CH1 ദ
+static uint8_t dual_frames[2][WAVEFORM_POINTS];
+
+static void make_dual_frame(uint8_t *pairs, int slots, double phase)
+{
+    int i;
+
+    for (i = 0; i < slots; i++) {
+        pairs[2 * i] = (uint8_t)lround(128.0 + 95.0 * sin(2.0 * M_PI * (2.5 * i / slots + phase / 360.0)));
+        pairs[2 * i + 1] = (uint8_t)lround(118.0 + 60.0 * sin(2.0 * M_PI * (4.0 * i / slots + phase / 180.0)));
+    }
+}
+
+// ʾҳʾ 0 ֡ͨ, Ȼе˫ͨ
+static void prepare_dual(void)
+{
+    prepare_scope();
+    make_dual_frame(dual_frames[0], WAVEFORM_POINTS / 2, 0.0);
+    make_dual_frame(dual_frames[1], WAVEFORM_POINTS / 2, 40.0);
+    Draw_Scope_Dual(dual_frames[0], WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+    scope_frame_index = 1;
+}
+
+static void run_scope_dual(void)
+{
+    Draw_Scope_Dual(dual_frames[scope_frame_index], WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+    scope_frame_index ^= 1;
+}
+
+static const Bench_Case_t bench_cases[] = {
+    { "Display_Main_board", prepare_main,   run_main        },
+    { "Display_Analog_in",  prepare_analog, run_analog      },
+    { "scope_full_512",     prepare_scope,  run_scope_full  },
+    { "scope_frame_512",    prepare_scope,  run_scope_frame },
+    { "scope_envelope_256", prepare_envelope, run_scope_envelope },
+    { "scope_spectrum_256", prepare_spectrum, run_scope_spectrum },
+    { "scope_roll_16",      prepare_roll,   run_scope_roll  },
+    { "scope_dual_256",     prepare_dual,   run_scope_dual  },
+};
+
+// У: ƵĽػĽһ
+static int check_scope_incremental(void)
+{
+    static uint16_t incremental[NT35510_HEIGHT][NT35510_WIDTH];
+    int x, y, diff = 0;
+
+    prepare_scope();
+    run_scope_frame();
+    memcpy(incremental, nt35510_gram, sizeof(incremental));
+
+    prepare_scope();
+    run_scope_full();
+
+    for (y = 0; y < NT35510_HEIGHT; y++)
+        for (x = 0; x < NT35510_WIDTH; x++)
+            if (incremental[y][x] != nt35510_gram[y][x])
+                diff++;
+    return diff;
+}
+
+// ----------------------------------------------------------------------------
+//  Draw_Scope_Waveform ΢׼: òұ֮ǰʵֶԱ
+// ----------------------------------------------------------------------------
+
+// ǰʵ ( + Cohen-Sutherland 󽻲ü), ڶԱ.
+// legacy_divs ͳִеĳ: Ӳ, M1 ÿγһ.
+static uint32_t legacy_divs;
+#define LDIV(a, b) (legacy_divs++, (a) / (b))
+static int legacy_outcode(int x, int y, Box_XY b)
+{
+    int code = 0;
+    if (x < b.X1) code |= 1;
+    else if (x > b.X1 + b.Width - 1) code |= 2;
+    if (y < b.Y1) code |= 8;
+    else if (y > b.Y1 + b.Height - 1) code |= 4;
+    return code;
+}
+
+static void legacy_clipped_line(int x0, int y0, int x1, int y1, uint32_t color, Box_XY b)
+{
+    int oc0 = legacy_outcode(x0, y0, b);
+    int oc1 = legacy_outcode(x1, y1, b);
+
+    while (1) {
+        if (!(oc0 | oc1)) {
+            lcd_draw_line(x0, y0, x1, y1, color);
+            return;
+        } else if (oc0 & oc1) {
+            return;
+        } else {
+            int x, y;
+            int out = oc0 ? oc0 : oc1;
+            if (out & 8)      { x = x0 + LDIV((x1 - x0) * (b.Y1 - y0), (y1 - y0)); y = b.Y1; }
+            else if (out & 4) { x = x0 + LDIV((x1 - x0) * (b.Y1 + b.Height - 1 - y0), (y1 - y0)); y = b.Y1 + b.Height - 1; }
+            else if (out & 2) { y = y0 + LDIV((y1 - y0) * (b.X1 + b.Width - 1 - x0), (x1 - x0)); x = b.X1 + b.Width - 1; }
+            else              { y = y0 + LDIV((y1 - y0) * (b.X1 - x0), (x1 - x0)); x = b.X1; }
+            if (out == oc0) { x0 = x; y0 = y; oc0 = legacy_outcode(x0, y0, b); }
+            else            { x1 = x; y1 = y; oc1 = legacy_outcode(x1, y1, b); }
+        }
+    }
+}
+
+static void legacy_scope_waveform(uint8_t *buffer, int points, Box_XY board, uint16_t volts_per_div_mv)
+{
+    const int32_t VOLTS_PER_SCREEN_MV = (int32_t)volts_per_div_mv * 8;
+    const int32_t y_center = board.Y1 + board.Height / 2;
+    const int32_t y_half_height = board.Height / 2;
+    int i;
+
+    for (i = 0; i < points - 1; i++) {
+        int ax = board.X1 + LDIV((long)(i * (board.Width - 1)), (points - 1));
+        int32_t va = LDIV(((int32_t)buffer[i] - 128) * ADC_FSR_MV, 128);
+        int ay = y_center - LDIV((long)(va * y_half_height), (VOLTS_PER_SCREEN_MV / 2));
+        int bx = board.X1 + LDIV((long)((i + 1) * (board.Width - 1)), (points - 1));
+        int32_t vb = LDIV(((int32_t)buffer[i + 1] - 128) * ADC_FSR_MV, 128);
+        int by = y_center - LDIV((long)(vb * y_half_height), (VOLTS_PER_SCREEN_MV / 2));
+        legacy_clipped_line(ax, ay, bx, by, 0xAFE5, board);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t bench_cycles(void) { return __rdtsc(); }
+#define CYCLE_UNIT "tsc"
+#else
+static uint64_t bench_cycles(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+#define CYCLE_UNIT "ns"
+#endif
+
+// ֻͳƲλƱ: ÿ(ʱ)ػ, ټʱһ֡.
+// LCD ģΪֻ, ʹҪӳ껻/üCPU.
+static void bench_scope_trace(int iterations, uint16_t mv)
+{
+    uint64_t legacy = 0, cur = 0, c0;
+    uint32_t legacy_bus, cur_bus;
+    int k;
+
+    prepare_scope();
+    nt35510_set_count_only(1);
+    legacy_divs = 0;
+    for (k = 0; k < iterations; k++) {
+        Draw_Scope_Grid(Analog_WaveBoard);
+        nt35510_stat_reset();
+        c0 = bench_cycles();
+        legacy_scope_waveform(scope_frames[k & 1], WAVEFORM_POINTS, Analog_WaveBoard, mv);
+        legacy += bench_cycles() - c0;
+    }
+    legacy_bus = nt35510_stat.cmd_writes + nt35510_stat.data_writes;
+
+    for (k = 0; k < iterations; k++) {
+        Draw_Scope_Grid(Analog_WaveBoard);
+        nt35510_stat_reset();
+        c0 = bench_cycles();
+        Draw_Scope_Waveform(scope_frames[k & 1], WAVEFORM_POINTS, Analog_WaveBoard, mv);
+        cur += bench_cycles() - c0;
+    }
+    cur_bus = nt35510_stat.cmd_writes + nt35510_stat.data_writes;
+    nt35510_set_count_only(0);
+
+    printf("trace %4umV/div  legacy %8llu %s %5lu div  |  current %8llu %s 0 div  (bus writes %lu -> %lu)\n",
+           mv, (unsigned long long)(legacy / iterations), CYCLE_UNIT,
+           (unsigned long)(legacy_divs / iterations),
+           (unsigned long long)(cur / iterations), CYCLE_UNIT,
+           (unsigned long)legacy_bus, (unsigned long)cur_bus);
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// 洢: Զڻʱ, ÿ֡дӦֻй
+static void bench_scope_deep(int points, int iterations)
+{
+    uint8_t *frames[2];
+    double t0, t1;
+    uint32_t bus;
+    int i, f, k;
+
+    for (f = 0; f < 2; f++) {
+        frames[f] = malloc(points);
+        for (i = 0; i < points; i++) {
+            // 20 ڵ, α, ʹÿжһ min/max Χ
+            double v = 90.0 * sin(2.0 * M_PI * (20.0 * i / points + f / 9.0));
+            frames[f][i] = (uint8_t)lround(128.0 + v + (double)((i * 1103515245u + 12345u) >> 28) - 8.0);
+        }
+    }
+
+    nt35510_model_reset(LCD_BLACK);
+    Display_Analog_in();
+    Draw_Scope_Waveform(frames[0], points, Analog_WaveBoard, 1000);
+    nt35510_stat_reset();
+    Draw_Scope_Waveform(frames[1], points, Analog_WaveBoard, 1000);
+    bus = nt35510_stat.cmd_writes + nt35510_stat.data_writes;
+
+    t0 = now_us();
+    for (k = 0; k < iterations; k++)
+        Draw_Scope_Waveform(frames[k & 1], points, Analog_WaveBoard, 1000);
+    t1 = now_us();
+
+    printf("scope_frame_%-8d bus writes %7lu   %9.1f us/call\n",
+           points, (unsigned long)bus, (t1 - t0) / iterations);
+    free(frames[0]);
+    free(frames[1]);
+}
+
+// У: лƵĲαǰλߵĽһ (βʱ)
+static int check_scope_vs_legacy(void)
+{
+    static uint16_t legacy[NT35510_HEIGHT][NT35510_WIDTH];
+    int x, y, diff = 0;
+
+    prepare_scope();
+    Draw_Scope_Grid(Analog_WaveBoard);
+    legacy_scope_waveform(scope_frames[1], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+    memcpy(legacy, nt35510_gram, sizeof(legacy));
+
+    prepare_scope();
+    Draw_Scope_Grid(Analog_WaveBoard);
+    Draw_Scope_Waveform(scope_frames[1], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+
+    for (y = 0; y < NT35510_HEIGHT; y++)
+        for (x = 0; x < NT35510_WIDTH; x++)
+            if (legacy[y][x] != nt35510_gram[y][x])
+                diff++;
+    return diff;
+}
+
+// У: ֵ Q8.8  (СΪ 0) ͬ 8 λ㻭ȫһ
+static int check_scope_q8_vs_u8(void)
+{
+    static uint16_t u8_result[NT35510_HEIGHT][NT35510_WIDTH];
+    static uint16_t q8[WAVEFORM_POINTS / 2];
+    int x, y, diff = 0;
+
+    prepare_scope();
+    for (x = 0; x < WAVEFORM_POINTS / 2; x++)
+        q8[x] = (uint16_t)(scope_frames[1][x] << 8);
+
+    Draw_Scope_Grid(Analog_WaveBoard);
+    Draw_Scope_Waveform(scope_frames[1], WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+    memcpy(u8_result, nt35510_gram, sizeof(u8_result));
+
+    Draw_Scope_Grid(Analog_WaveBoard);
+    Draw_Scope_Waveform16(q8, WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+
+    for (y = 0; y < NT35510_HEIGHT; y++)
+        for (x = 0; x < NT35510_WIDTH; x++)
+            if (u8_result[y][x] != nt35510_gram[y][x])
+                diff++;
+    return diff;
+}
+
+// У: ҵĵʵĵƽԽ,  (ͬλб)
+static int check_scope_trigger(void)
+{
+    static uint8_t frame[WAVEFORM_POINTS];
+    Scope_Trigger trig = { 128, 4, 0, 8 };
+    const int pre = WAVEFORM_POINTS / 4, window = WAVEFORM_POINTS / 2;
+    int k, bad = 0;
+
+    for (k = 0; k < 64; k++) {
+        int t;
+        make_sine_frame(frame, WAVEFORM_POINTS, k * (360.0 / 64));
+        trig.falling = k & 1;
+        t = Scope_Trigger_Find(frame, WAVEFORM_POINTS, 1, pre, pre + window, &trig);
+        if (t < pre || t >= pre + window || t == 0)
+            bad++;
+        else if (!trig.falling && !(frame[t - 1] < trig.level && frame[t] >= trig.level))
+            bad++;
+        else if (trig.falling && !(frame[t - 1] > trig.level && frame[t] <= trig.level))
+            bad++;
+    }
+    return bad;
+}
+
+// У: ӲеƵʱֻλ, ڸɾϻƵһ
+static int check_scope_spectrum(void)
+{
+    static uint16_t switched[NT35510_HEIGHT][NT35510_WIDTH];
+    int x, y, diff = 0;
+
+    prepare_spectrum();             //  -> Ƶ
+    run_scope_spectrum();           // Ƶ -> Ƶ
+    memcpy(switched, nt35510_gram, sizeof(switched));
+
+    prepare_scope();
+    Draw_Scope_Grid(Analog_WaveBoard);
+    Draw_Scope_Spectrum(spectrum_frames[1], SCOPE_FFT_N / 2, Analog_WaveBoard);
+
+    for (y = 0; y < NT35510_HEIGHT; y++)
+        for (x = 0; x < NT35510_WIDTH; x++)
+            if (switched[y][x] != nt35510_gram[y][x])
+                diff++;
+    return diff;
+}
+
+// У: ͨ -> ˫ͨ -> ˫ͨ -> ͨ, ÿһڸɾϻĽһ
+// (ڶ·Ĳŵһ·, лصͨʱҲҪɾ)
+static int check_scope_dual(void)
+{
+    static uint16_t switched[NT35510_HEIGHT][NT35510_WIDTH];
+    int x, y, diff = 0, step;
+
+    for (step = 0; step < 2; step++) {
+        prepare_dual();             // ͨ -> ˫ͨ
+        run_scope_dual();           // ˫ͨ -> ˫ͨ
+        if (step == 1)
+            Draw_Scope_Waveform(scope_frames[1], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+        memcpy(switched, nt35510_gram, sizeof(switched));
+
+        prepare_scope();
+        Draw_Scope_Grid(Analog_WaveBoard);
+        if (step == 0)
+            Draw_Scope_Dual(dual_frames[1], WAVEFORM_POINTS / 2, Analog_WaveBoard, 1000);
+        else
+            Draw_Scope_Waveform(scope_frames[1], WAVEFORM_POINTS, Analog_WaveBoard, 1000);
+
+        for (y = 0; y < NT35510_HEIGHT; y++)
+            for (x = 0; x < NT35510_WIDTH; x++)
+                if (switched[y][x] != nt35510_gram[y][x])
+                    diff++;
+    }
+    return diff;
+}
+
+// У: 븡οֵ (ѹ <= 2 , οͬ)
+static int check_scope_measure(void)
+{
+    static uint8_t frame[WAVEFORM_POINTS];
+    static Scope_Meas m;
+    Scope_Meas_Result r;
+    const int32_t lsb_mv = ADC_FSR_MV / 128 + 1;
+    int k, i, bad = 0;
+
+    for (k = 0; k < 16; k++) {
+        double sum = 0, sq = 0, mn = 1e9, mx = -1e9;
+        make_sine_frame(frame, WAVEFORM_POINTS, k * (360.0 / 16));
+
+        Scope_Meas_Begin(&m);
+        for (i = 0; i < WAVEFORM_POINTS; i++) {
+            double v = (frame[i] - 128) * (double)ADC_FSR_MV / 128;
+            sum += v; sq += v * v;
+            if (v < mn) mn = v;
+            if (v > mx) mx = v;
+            Scope_Meas_Add(&m, ((int32_t)frame[i] - 128) << 4);
+        }
+        Scope_Meas_Finish(&m, &r);
+
+        if (k == 0) continue;   // һ֡Ĺƽûвο
+        if (labs(r.vmin_mv - lround(mn)) > lsb_mv || labs(r.vmax_mv - lround(mx)) > lsb_mv ||
+            labs(r.vavg_mv - lround(sum / WAVEFORM_POINTS)) > lsb_mv ||
+            labs(r.vrms_mv - lround(sqrt(sq / WAVEFORM_POINTS))) > lsb_mv)
+            bad++;
+        // 2.5 : Խ 2~3 ,  1~2,  =  * 204.8 
+        else if (r.cycles < 1 || labs(r.span - lround(r.cycles * WAVEFORM_POINTS / 2.5)) > 1)
+            bad++;
+    }
+    return bad;
+}
+
+// У: ¼ȽȳƲ˶¼¼ȡǰֻͶһ
+static int check_event_queue(void)
+{
+    Event_t e;
+    uint32_t next = 0;
+    int k, bad = 0;
+
+    Event_Queue_Init();
+    for (k = 0; k < 1000; k++) {
+        // ÿͶ k % 20  (ܳг), ȫȡ
+        int n = k % 20, got = 0;
+        uint32_t first = next;
+        uint32_t dropped = event_stats.dropped;
+        for (int j = 0; j < n; j++)
+            Event_Post(EVT_FPGA, next++);
+        while (Event_Get(&e)) {
+            if (e.type != EVT_FPGA || e.arg != first + got) bad++;
+            got++;
+        }
+        if (got != (n < EVENT_QUEUE_SIZE ? n : EVENT_QUEUE_SIZE)) bad++;
+        if (event_stats.dropped - dropped != (uint32_t)(n - got)) bad++;
+    }
+
+    Event_Queue_Init();
+    g_tick_count = 0;
+    for (k = 0; k < 5; k++) { Time_Tick_ISR(); Event_Tick_ISR(); }
+    if (!Event_Get(&e) || e.type != EVT_TICK || Event_Get(&e)) bad++;
+    Time_Tick_ISR();
+    Event_Tick_ISR();
+    if (!Event_Get(&e) || e.type != EVT_TICK || e.arg != 6) bad++;
+    return bad;
+}
+
+// У: ͬһİ˳Сʱ late Ҳ
+static char sched_trace[64];
+static int  sched_trace_len;
+static void sched_task_a(void) { if (sched_trace_len < 63) sched_trace[sched_trace_len++] = 'a'; }
+static void sched_task_b(void) { if (sched_trace_len < 63) sched_trace[sched_trace_len++] = 'b'; }
+static void sched_task_e(void) { }
+
+static int check_scheduler(void)
+{
+    static Sched_Task_t tasks[] = {
+        { "a", 2, sched_task_a },
+        { "b", 5, sched_task_b },
+        { "e", 0, sched_task_e },
+    };
+    uint32_t now;
+    int bad = 0;
+
+    Sched_Init(tasks, 3, 0);
+    sched_trace_len = 0;
+    for (now = 1; now <= 10; now++)
+        Sched_Tick(now);
+    sched_trace[sched_trace_len] = 0;
+    //  2,4,5,6,8,10 (ͬһ a  b ֮ǰ)
+    if (strcmp(sched_trace, "aabaaab") != 0) bad++;
+    if (tasks[0].count != 5 || tasks[1].count != 2 || tasks[2].count != 0) bad++;
+
+    // һοס 20 : ֻһβ late, ֮ӵǰ¼
+    Sched_Tick(30);
+    if (tasks[0].count != 6 || tasks[1].count != 3 || tasks[0].late != 1 || tasks[1].late != 1) bad++;
+    Sched_Tick(31);
+    Sched_Tick(32);
+    if (tasks[0].count != 7 || tasks[0].late != 1) bad++;
+
+    Sched_Run(&tasks[2]);
+    if (tasks[2].count != 1) bad++;
+    return bad;
+}
+
+// У: ΢ =  + SysTick ߹ļ; ֹʱԽ 32 λȻȷ
+static int check_systime(void)
+{
+    uint32_t d;
+    int bad = 0;
+
+    Time_Init();                                  // LOAD = 49999
+    g_tick_count = 123;
+    host_systick.VAL = host_systick.LOAD;         // ĸտʼ
+    if (Time_us() != 123000) bad++;
+    host_systick.VAL = host_systick.LOAD - 25000; // ˰
+    if (Time_us() != 123500) bad++;
+    host_systick.VAL = 0;                         // ĩβ: 󲻳һĵ
+    if (Time_us() < 123999 || Time_us() > 124000) bad++;
+
+    g_tick_count = 0xFFFFFFF0u;
+    d = Time_Deadline_ms(0x20);
+    if (Time_Expired_ms(d)) bad++;
+    g_tick_count += 0x1F;
+    if (Time_Expired_ms(d)) bad++;
+    g_tick_count += 1;
+    if (!Time_Expired_ms(d)) bad++;
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    int q, t, s, f, d, e, c, m;
+    int iterations = 50;
+    const char *ppm_dir = NULL;
+    size_t i;
+    int k;
+
+    for (k = 1; k < argc; k++)
+    {
+        if (strcmp(argv[k], "-n") == 0 && k + 1 < argc)
+            iterations = atoi(argv[++k]);
+        else if (strcmp(argv[k], "-o") == 0 && k + 1 < argc)
+            ppm_dir = argv[++k];
+        else
+        {
+            fprintf(stderr, "usage: %s [-n iterations] [-o ppm_dir]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (iterations < 1)
+        iterations = 1;
+
+    printf("%-20s %10s %10s %10s %10s %12s\n",
+           "case", "cmd", "data", "total", "windows", "us/call");
+
+    for (i = 0; i < sizeof(bench_cases) / sizeof(bench_cases[0]); i++)
+    {
+        const Bench_Case_t *bc = &bench_cases[i];
+        NT35510_Stat_t one;
+        double t0, t1;
+
+        // һ: ͳƵεõ߷ʲ
+        bc->prepare();
+        nt35510_stat_reset();
+        bc->run();
+        one = nt35510_stat;
+
+        if (ppm_dir != NULL)
+        {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s.ppm", ppm_dir, bc->name);
+            if (nt35510_dump_ppm(path) != 0)
+                fprintf(stderr, "cannot write %s\n", path);
+        }
+
+        // ظ: ͳǽʱ (׼ʱ)
+        bc->prepare();
+        t0 = now_us();
+        for (k = 0; k < iterations; k++)
+            bc->run();
+        t1 = now_us();
+
+        printf("%-20s %10lu %10lu %10lu %10lu %12.1f\n", bc->name,
+               (unsigned long)one.cmd_writes, (unsigned long)one.data_writes,
+               (unsigned long)(one.cmd_writes + one.data_writes),
+               (unsigned long)one.windows, (t1 - t0) / iterations);
+    }
+
+    printf("\nDraw_Scope_Waveform per frame (mapping + clipping, LCD model count-only):\n");
+    bench_scope_trace(iterations, 1000);
+    bench_scope_trace(iterations, 100);   // 󲿷ֵ㳬, ü·Ϊ
+
+    printf("\nDeep captures (column min/max renderer):\n");
+    bench_scope_deep(4096, iterations);
+    bench_scope_deep(65536, iterations / 10 + 1);
+
+    printf("\n");
+    k = check_scope_incremental();
+    printf("scope incremental vs full redraw: %s (%d pixels differ)\n", k ? "MISMATCH" : "OK", k);
+    i = check_scope_vs_legacy();
+    printf("scope columns vs legacy segments: %s (%d pixels differ)\n", i ? "MISMATCH" : "OK", (int)i);
+    q = check_scope_q8_vs_u8();
+    printf("scope Q8.8 vs 8-bit samples:      %s (%d pixels differ)\n", q ? "MISMATCH" : "OK", q);
+
+    t = check_scope_trigger();
+    printf("software trigger crossings:       %s (%d frames wrong)\n", t ? "MISMATCH" : "OK", t);
+
+    s = check_scope_measure();
+    printf("fixed-point measurements:         %s (%d frames wrong)\n", s ? "MISMATCH" : "OK", s);
+
+    f = check_scope_spectrum();
+    printf("spectrum after waveform:          %s (%d pixels differ)\n", f ? "MISMATCH" : "OK", f);
+
+    d = check_scope_dual();
+    printf("dual channel incremental:         %s (%d pixels differ)\n", d ? "MISMATCH" : "OK", d);
+
+    e = check_event_queue();
+    printf("event queue order/overflow/tick:  %s (%d errors)\n", e ? "MISMATCH" : "OK", e);
+
+    c = check_scheduler();
+    printf("scheduler periods/priority/late:  %s (%d errors)\n", c ? "MISMATCH" : "OK", c);
+
+    m = check_systime();
+    printf("systime us/deadline wrap:         %s (%d errors)\n", m ? "MISMATCH" : "OK", m);
+
+    return (k || i || q || t || s || f || d || e || c || m) ? 2 : 0;
+}
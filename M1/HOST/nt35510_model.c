@@ -0,0 +1,155 @@
+#include "nt35510_model.h"
+#include <stdio.h>
+
+NT35510_Stat_t nt35510_stat;
+uint16_t nt35510_gram[NT35510_HEIGHT][NT35510_WIDTH];
+
+// ״̬
+static uint16_t cur_cmd;                // һд
+static uint16_t col_start, col_end;     // д (0x2A00~0x2A03)
+static uint16_t row_start, row_end;     // д (0x2B00~0x2B03)
+static uint16_t cur_x, cur_y;           // Դдָ
+static uint8_t  read_phase;             // 0:dummy 1:R/G 2:B
+static int      count_only;             // ֻģʽ
+
+void nt35510_set_count_only(int enable)
+{
+    count_only = enable;
+}
+
+void nt35510_stat_reset(void)
+{
+    nt35510_stat.cmd_writes = 0;
+    nt35510_stat.data_writes = 0;
+    nt35510_stat.data_reads = 0;
+    nt35510_stat.windows = 0;
+    nt35510_stat.pixels = 0;
+}
+
+void nt35510_model_reset(uint16_t color)
+{
+    int x, y;
+
+    for (y = 0; y < NT35510_HEIGHT; y++)
+        for (x = 0; x < NT35510_WIDTH; x++)
+            nt35510_gram[y][x] = color;
+
+    cur_cmd = 0;
+    col_start = 0; col_end = NT35510_WIDTH - 1;
+    row_start = 0; row_end = NT35510_HEIGHT - 1;
+    cur_x = 0; cur_y = 0;
+    read_phase = 0;
+    nt35510_stat_reset();
+}
+
+// ָ: к, ﴰĩβص
+static void advance_cursor(void)
+{
+    if (cur_x >= col_end)
+    {
+        cur_x = col_start;
+        cur_y = (cur_y >= row_end) ? row_start : (uint16_t)(cur_y + 1);
+    }
+    else
+    {
+        cur_x++;
+    }
+}
+
+void nt35510_write_cmd(uint16_t reg)
+{
+    nt35510_stat.cmd_writes++;
+    if (count_only)
+        return;
+    cur_cmd = reg;
+
+    if (reg == 0x2C00 || reg == 0x2E00)
+    {
+        cur_x = col_start;
+        cur_y = row_start;
+        read_phase = 0;
+        nt35510_stat.windows++;
+    }
+}
+
+void nt35510_write_data(uint16_t data)
+{
+    nt35510_stat.data_writes++;
+    if (count_only)
+        return;
+
+    switch (cur_cmd)
+    {
+        case 0x2A00: col_start = (uint16_t)((col_start & 0x00FF) | ((data & 0xFF) << 8)); break;
+        case 0x2A01: col_start = (uint16_t)((col_start & 0xFF00) | (data & 0xFF));        break;
+        case 0x2A02: col_end   = (uint16_t)((col_end   & 0x00FF) | ((data & 0xFF) << 8)); break;
+        case 0x2A03: col_end   = (uint16_t)((col_end   & 0xFF00) | (data & 0xFF));        break;
+        case 0x2B00: row_start = (uint16_t)((row_start & 0x00FF) | ((data & 0xFF) << 8)); break;
+        case 0x2B01: row_start = (uint16_t)((row_start & 0xFF00) | (data & 0xFF));        break;
+        case 0x2B02: row_end   = (uint16_t)((row_end   & 0x00FF) | ((data & 0xFF) << 8)); break;
+        case 0x2B03: row_end   = (uint16_t)((row_end   & 0xFF00) | (data & 0xFF));        break;
+        case 0x2C00:
+            if (cur_x < NT35510_WIDTH && cur_y < NT35510_HEIGHT)
+            {
+                nt35510_gram[cur_y][cur_x] = data;
+                nt35510_stat.pixels++;
+            }
+            advance_cursor();
+            break;
+        default:
+            // ʼĴĲ, ģͲ
+            break;
+    }
+}
+
+//  lcd_read_point Ķһ: dummy, [15:11]R [7:2]G, [15:11]B
+uint16_t nt35510_read_data(void)
+{
+    uint16_t color;
+    uint16_t ret = 0;
+
+    nt35510_stat.data_reads++;
+    if (cur_cmd != 0x2E00 || cur_x >= NT35510_WIDTH || cur_y >= NT35510_HEIGHT)
+        return 0;
+
+    color = nt35510_gram[cur_y][cur_x];
+    switch (read_phase)
+    {
+        case 0: ret = 0; read_phase = 1; break;
+        case 1: ret = (uint16_t)((color & 0xF800) | (((color >> 5) & 0x3F) << 2)); read_phase = 2; break;
+        default:
+            ret = (uint16_t)((color & 0x1F) << 11);
+            read_phase = 1;
+            advance_cursor();
+            break;
+    }
+    return ret;
+}
+
+//  PPM(P6) ʽǰԴ, RGB565 չΪ RGB888
+int nt35510_dump_ppm(const char *path)
+{
+    FILE *fp;
+    int x, y;
+    uint16_t c;
+    unsigned char rgb[3];
+
+    fp = fopen(path, "wb");
+    if (fp == NULL)
+        return -1;
+
+    fprintf(fp, "P6\n%d %d\n255\n", NT35510_WIDTH, NT35510_HEIGHT);
+    for (y = 0; y < NT35510_HEIGHT; y++)
+    {
+        for (x = 0; x < NT35510_WIDTH; x++)
+        {
+            c = nt35510_gram[y][x];
+            rgb[0] = (unsigned char)(((c >> 11) & 0x1F) * 255 / 31);
+            rgb[1] = (unsigned char)(((c >> 5) & 0x3F) * 255 / 63);
+            rgb[2] = (unsigned char)((c & 0x1F) * 255 / 31);
+            fwrite(rgb, 1, 3, fp);
+        }
+    }
+    fclose(fp);
+    return 0;
+}
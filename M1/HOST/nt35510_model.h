@@ -0,0 +1,35 @@
+#ifndef __NT35510_MODEL_H__
+#define __NT35510_MODEL_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  NT35510 ģ ()
+//  ֻʵֻͼõ: 0x2A00~0x2A03 еַ, 0x2B00~0x2B03 еַ,
+//  0x2C00 дԴ, 0x2E00 Դ. Ϊ 0x3600=0xA0 () µ߼.
+// ============================================================================
+
+#define NT35510_WIDTH   800
+#define NT35510_HEIGHT  480
+
+typedef struct
+{
+    uint32_t cmd_writes;    // д (LCD->LCD_REG)
+    uint32_t data_writes;   // д (LCD->LCD_RAM)
+    uint32_t data_reads;    // ݶ
+    uint32_t windows;       // 0x2C00/0x2E00 򿪴ڵĴ
+    uint32_t pixels;        // ʵдԴ
+} NT35510_Stat_t;
+
+extern NT35510_Stat_t nt35510_stat;
+extern uint16_t nt35510_gram[NT35510_HEIGHT][NT35510_WIDTH];
+
+void     nt35510_model_reset(uint16_t color);
+void     nt35510_stat_reset(void);
+void     nt35510_set_count_only(int enable); // 1: ֻԴ, ڲCPU
+void     nt35510_write_cmd(uint16_t reg);
+void     nt35510_write_data(uint16_t data);
+uint16_t nt35510_read_data(void);
+int      nt35510_dump_ppm(const char *path);
+
+#endif /* __NT35510_MODEL_H__ */
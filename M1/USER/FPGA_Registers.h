@@ -6,7 +6,9 @@
 // ============================================================================
 // AHB2 ַ
 // ============================================================================
+#ifndef FPGA_PERIPH_BASE
 #define FPGA_PERIPH_BASE 0x81000000U
+#endif
 
 // ============================================================================
 // Section 1: ģʽѡĴ
@@ -83,9 +85,15 @@ enum {
 #define ANALOG_CONTROL_REG     (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x08))
 #define ANALOG_STATUS_REG      (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x0C))
 #define ANALOG_DECIM_REG       (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x28))
+#define ANALOG_ROLL_POS_REG    (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x38)) // ֻ, ʽʵʱ
+#define ANALOG_TRIG_REG        (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x3C))
+#define ANALOG_TRIG_POS_REG    (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x40)) // ֻ, ÿ֡ READY 
 	
 // ** ݻַָΪ uint8_t* **
 #define ANALOG_DATA_BUFFER     ((volatile uint8_t*)(FPGA_PERIPH_BASE + 0x100)) //512λ
+// ** ͬһ 32 λַ: ÿ 4 , С (bit[7:0] Ϊ),  128  **
+#define ANALOG_DATA_WORDS      ((volatile uint32_t*)(FPGA_PERIPH_BASE + 0x100))
+#define ANALOG_DATA_WORD_COUNT (128)
 
 // --- ANALOG_CONTROL_REG (0x81000008) дλ ---
 #define ANALOG_CTRL_START_STOP_Pos (0)
@@ -93,9 +101,93 @@ enum {
 #define ANALOG_CTRL_ACK_DATA_Pos   (1)
 #define ANALOG_CTRL_ACK_DATA_Msk   (1U << ANALOG_CTRL_ACK_DATA_Pos)   // bit 1: M1д1,֪ͨFPGAȡ
 
+// --- ANALOG_DECIM_REG (0x81000028) λ ---
+#define ANALOG_DECIM_N_Pos     (0)
+#define ANALOG_DECIM_N_Msk     (0xFFFFU << ANALOG_DECIM_N_Pos)   // [15:0]: ȡֵ N (С5ʱFPGAĬֵ)
+#define ANALOG_DECIM_MODE_Pos  (16)
+#define ANALOG_DECIM_MODE_Msk  (0x3U << ANALOG_DECIM_MODE_Pos)   // [17:16]: ȡʽ
+#define ANALOG_DECIM_ROLL_Pos  (18)
+#define ANALOG_DECIM_ROLL_Msk  (1U << ANALOG_DECIM_ROLL_Pos)     // bit 18: 1=ʽ, ֡ READY, Դ
+#define ANALOG_DECIM_DUAL_Pos  (19)
+#define ANALOG_DECIM_DUAL_Msk  (1U << ANALOG_DECIM_DUAL_Pos)     // bit 19: 1=˫ͨ, ̶ȡ, ÿ N д {AD0, AD1} ֽڶ, 256 
+enum {
+    ANALOG_DECIM_SAMPLE, // 00: ȡ, ÿ N ȡ 1 , 512 
+    ANALOG_DECIM_PEAK,   // 01: ֵ, ÿ 2N һ,  {min, max} ֽڶ, 256 
+    ANALOG_DECIM_AVG,    // 10: ƽ, ÿ 2N һ, ֵ (Q8.8, С 16 λ), 256 
+    ANALOG_DECIM_MODE_COUNT
+};
+
+// --- ANALOG_TRIG_REG (0x8100003C) λ (κθĶFPGA¿ʼǰ֡) ---
+#define ANALOG_TRIG_LEVEL_Pos   (0)
+#define ANALOG_TRIG_LEVEL_Msk   (0xFFU << ANALOG_TRIG_LEVEL_Pos)   // [7:0]:   ƽ (ADC ֵ)
+#define ANALOG_TRIG_HYST_Pos    (8)
+#define ANALOG_TRIG_HYST_Msk    (0xFFU << ANALOG_TRIG_HYST_Pos)    // [15:8]:  ز, Խ ƽ-/+ز װ
+#define ANALOG_TRIG_PRE_Pos     (16)
+#define ANALOG_TRIG_PRE_Msk     (0x1FFU << ANALOG_TRIG_PRE_Pos)    // [24:16]: Ԥ (ֽ, ֵ/ƽʽȡż)
+#define ANALOG_TRIG_FALLING_Pos (25)
+#define ANALOG_TRIG_FALLING_Msk (1U << ANALOG_TRIG_FALLING_Pos)    // bit 25: 0=, 1=½
+#define ANALOG_TRIG_EN_Pos      (26)
+#define ANALOG_TRIG_EN_Msk      (1U << ANALOG_TRIG_EN_Pos)         // bit 26: 1=ʹ, 0=
+#define ANALOG_TRIG_AUTO_Pos    (27)
+#define ANALOG_TRIG_AUTO_Msk    (1U << ANALOG_TRIG_AUTO_Pos)       // bit 27: 1=һȦޱǿƳ֡
+
+// --- ANALOG_TRIG_POS_REG (0x81000040) λ ---
+#define ANALOG_TRIG_POS_START_Pos (0)
+#define ANALOG_TRIG_POS_START_Msk (0x1FFU << ANALOG_TRIG_POS_START_Pos) // [8:0]: ֽ֡ڵַ, ת
+#define ANALOG_TRIG_POS_HIT_Pos   (9)
+#define ANALOG_TRIG_POS_HIT_Msk   (1U << ANALOG_TRIG_POS_HIT_Pos)       // bit 9: 1=֡ɱش, 0=/Զ֡
+
+// --- ANALOG_ROLL_POS_REG (0x81000038) λ ---
+// ʽ FPGA ڵǰ bank һֱд,  k  (ɶԷʽΪ k ) ֽڵַ (k*) & 511,
+// ȡʽΪ 1, ֵ/ƽʽ˫ͨΪ 2. ú 0 ¿ʼ
+#define ANALOG_ROLL_POS_COUNT_Pos (0)
+#define ANALOG_ROLL_POS_COUNT_Msk (0xFFFFU << ANALOG_ROLL_POS_COUNT_Pos) // [15:0]: дĵ ()
+
 // --- ANALOG_STATUS_REG (0x8100000C) λ ---
 #define ANALOG_STATUS_DATA_READY_Pos (0)
 #define ANALOG_STATUS_DATA_READY_Msk (1U << ANALOG_STATUS_DATA_READY_Pos) // bit 0: 1=׼
+#define ANALOG_STATUS_BANK_Pos       (1)
+#define ANALOG_STATUS_BANK_Msk       (1U << ANALOG_STATUS_BANK_Pos)       // bit 1: ƹһеǰɶ bank (0/1)
+
+// --- Ԥͳ (ֻ, ɻƼ, ȡζ֮) ---
+#define ANALOG_STAT_FRAMES_REG  (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x44)) // ֡ (READY )
+#define ANALOG_STAT_DROPS_REG   (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x48)) // [15:0]: һ֡δ ACK ֡
+#define ANALOG_STAT_ACK_LAT_REG (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x4C)) // һ֡ READY -> ACK  HCLK 
+#define ANALOG_STAT_DISCARD_REG (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x50)) // ֡ ADC 
+#define FPGA_STAT_TICKS_REG     (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x54)) // HCLK ڼ
+#define ANALOG_STAT_DROPS_Msk   (0xFFFFU)
+#define FPGA_HCLK_HZ            (50000000U)  // HCLK = M1 ںʱ 50MHz
+
+// --- 洢 (DDR3): ¼ɽ DDR3, ٰȡ 512 ֽڵĳȡ/ͼ ---
+// ̫· DDR3, ̫ڼᱻܾ (ɺ OK λΪ 0); ̫ù DDR ¼
+#define DEEP_CTRL_REG          (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x58)) // ֻд
+#define DEEP_LEN_REG           (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x5C)) // ¼ (, 256 , 64K..1M)
+#define DEEP_DECIM_REG         (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x60)) // [15:0]: ɼȡֵ (ÿ N  ADC ȡ 1 , 0  1)
+#define DEEP_VIEW_START_REG    (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x64)) // [19:0]: ͼ (¼)
+#define DEEP_VIEW_STEP_REG     (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x68)) // [15:0]: ͼ (0  1)
+#define DEEP_STATUS_REG        (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x6C)) // ֻ
+// ** ͼ, ʽ ANALOG_DATA_WORDS ͬ: ÿ 4 , С,  128  **
+#define DEEP_VIEW_WORDS        ((volatile uint32_t*)(FPGA_PERIPH_BASE + 0x800))
+#define DEEP_LEN_MAX           (1U << 20)
+
+// --- DEEP_CTRL_REG (0x81000058) λ (д LEN/DECIM/VIEW_xxx дĴ; Ӧ BUSY λʱҪд) ---
+#define DEEP_CTRL_CAPTURE_Pos  (0)
+#define DEEP_CTRL_CAPTURE_Msk  (1U << DEEP_CTRL_CAPTURE_Pos)  // bit 0: д 1 ʼɼһ¼
+#define DEEP_CTRL_VIEW_Pos     (1)
+#define DEEP_CTRL_VIEW_Msk     (1U << DEEP_CTRL_VIEW_Pos)     // bit 1: д 1  VIEW_START/STEP ͼ
+#define DEEP_CTRL_MODE_Pos     (2)
+#define DEEP_CTRL_MODE_Msk     (0x3U << DEEP_CTRL_MODE_Pos)   // [3:2]: ͼʽ, ANALOG_DECIM_SAMPLE  ANALOG_DECIM_PEAK
+#define DEEP_CTRL_CH_Pos       (4)
+#define DEEP_CTRL_CH_Msk       (1U << DEEP_CTRL_CH_Pos)       // bit 4: ɼͨ 0=AD0, 1=AD1
+// ȡͼ: ÿ STEP ȡ 1 , 512 ; ֵͼ: ÿ 2*STEP һ {min, max}, 256 
+
+// --- DEEP_STATUS_REG (0x8100006C) λ (BUSY ڼӦ OK λΪ 0) ---
+#define DEEP_STATUS_CAP_BUSY_Msk  (1U << 0)   // ɼ
+#define DEEP_STATUS_CAP_OK_Msk    (1U << 1)   // DDR ¼
+#define DEEP_STATUS_VIEW_BUSY_Msk (1U << 2)   // ͼ
+#define DEEP_STATUS_VIEW_OK_Msk   (1U << 3)   // ͼЧ
+#define DEEP_STATUS_OVF_Msk       (1U << 4)   // ɼʱ DDR д FIFO , ¼ȱ
+#define DEEP_STATUS_DDR_OK_Msk    (1U << 5)   // DDR3 ʼ
 
 
 // ============================================================================
@@ -128,6 +220,26 @@ enum {
 #define CAPTURE_STATUS_READY_Pos    (0)
 #define CAPTURE_STATUS_READY_Msk    (1U << CAPTURE_STATUS_READY_Pos)
 
+// ========================================================================
+// Section 6: ݾж (FPGA  M1 EXTINT[0])
+// ========================================================================
+#define FPGA_IRQ_STATUS_REG    (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x30)) // : λ; д1
+#define FPGA_IRQ_ENABLE_REG    (*(volatile uint32_t*)(FPGA_PERIPH_BASE + 0x34)) // д: ʹλ
+
+// --- FPGA_IRQ_STATUS_REG / FPGA_IRQ_ENABLE_REG λ ( READY λ) ---
+#define FPGA_IRQ_ANALOG_READY_Pos   (0)
+#define FPGA_IRQ_ANALOG_READY_Msk   (1U << FPGA_IRQ_ANALOG_READY_Pos)   // ģԤһ֡
+#define FPGA_IRQ_DIGITAL_MEAS_Pos   (1)
+#define FPGA_IRQ_DIGITAL_MEAS_Msk   (1U << FPGA_IRQ_DIGITAL_MEAS_Pos)   // ֲ
+#define FPGA_IRQ_CAPTURE_READY_Pos  (2)
+#define FPGA_IRQ_CAPTURE_READY_Msk  (1U << FPGA_IRQ_CAPTURE_READY_Pos)  // ֲ
+#define FPGA_IRQ_ALL_Msk            (0x7U)
+
+// FPGA жϽ M1 ⲿж 0 
+#ifndef FPGA_IRQn
+#define FPGA_IRQn              EXTINT_0_IRQn
+#endif
+
 // ========================================================================
 // Section 7: USB CDC ģʽؼĴ
 // ========================================================================
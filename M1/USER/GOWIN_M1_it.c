@@ -11,6 +11,12 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "GOWIN_M1_it.h"
+#include "fpga_registers.h"
+#include "event_handler.h"
+#include "event_queue.h"
+#include "Touch.h"
+#include "i2c_async.h"
+#include "systime.h"
 
 
 /* Definitions ---------------------------------------------------------------*/
@@ -81,6 +87,10 @@ void PendSV_Handler(void)
   */
 void SysTick_Handler(void)
 {
+  /* 1 ms tick: count it and wake the main loop with an EVT_TICK */
+  Time_Tick_ISR();
+  Event_Tick_ISR();
+  I2C_Async_Tick();
 }
 
 /******************************************************************************/
@@ -151,6 +161,8 @@ void RTC_Handler(void)
   */
 void I2C_Handler(void)
 {
+  /* one byte (or STOP) finished: advance the queued transfer */
+  I2C_Async_IRQ();
 }
 
 /**
@@ -223,6 +235,9 @@ void GPIO0_2_Handler(void)
   */
 void GPIO0_3_Handler(void)
 {
+  /* GT1151 INT: new touch report, the main loop reads it over I2C */
+  GPIO0->INTCLEAR = TP_INT_PIN;
+  Event_Post_Once(EVT_TOUCH_INT, 0);
 }
 
 /**
@@ -340,6 +355,12 @@ void GPIO0_15_Handler(void)
   */
 void EXTINT_0_Handler(void)
 {
+  /* FPGA data-ready: latch the pending bits, then write 1 to clear them */
+  uint32_t status = FPGA_IRQ_STATUS_REG;
+
+  FPGA_IRQ_STATUS_REG = status;
+  g_fpga_irq_flags |= status;
+  Event_Post(EVT_FPGA, status);
 }
 
 /**
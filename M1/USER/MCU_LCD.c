@@ -1,17 +1,21 @@
 #include "MCU_LCD.h"
 #include "font.h"
 #include "math.h"
+#include "systime.h"
 
 uint16_t brush_color =LCD_BLACK; //ˢɫ
 uint16_t back_color  =LCD_WHITE; //ɫ
 
+#ifdef LCD_BUS_STAT
+LCD_Bus_Stat_t lcd_bus_stat; //LCDдͳ
 
-//delay
-static void delay_ms(__IO uint32_t nCount)
+void lcd_bus_stat_reset(void)
 {
-	nCount *= 4333;
-	for(; nCount != 0; nCount--);
+	lcd_bus_stat.cmd_writes = 0;
+	lcd_bus_stat.data_writes = 0;
 }
+#endif
+
 
 void mpu_write_reg(uint16_t reg, uint16_t dat)
 {
@@ -455,7 +459,7 @@ void mcu_lcd_reg_init(void)
 		mpu_write_reg(0x3500, 0x00);
 		mpu_write_reg(0x3A00, 0x55);
 		mpu_write_cmd(0x1100);
-		delay_ms(1);
+		Time_Delay_ms(1);
 		mpu_write_cmd(0x2900);
 	}
 	mpu_write_reg(0x3600, 0x00A0);
@@ -470,22 +474,54 @@ void set_display_on(void)
 
 void lcd_fill(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye, uint16_t color)
 {
-    uint16_t x_index;
-    uint16_t y_index;
+    uint32_t count;
     
     set_column_address(xs, xe);
     set_row_address(ys, ye);
     start_write_memory();
-    for (y_index=ys; y_index<=ye; y_index++)
+    //ڴ򿪺GRAMַԶ, ֻд
+    count = (uint32_t)(xe - xs + 1) * (ye - ys + 1);
+    while (count--)
     {
-        for (x_index=xs; x_index<= xe; x_index++)
-        {
-            mpu_write_data(color);
-        }
+        mpu_write_data(color);
     }
 }
 
 
+//һд, ֮ mpu_write_data ке˳д
+void lcd_set_window(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye)
+{
+    set_column_address(xs, xe);
+    set_row_address(ys, ye);
+    start_write_memory();
+}
+
+
+//еַϴ lcd_set_window , ֻзΧʼд (ͬһڻһʱд8)
+void lcd_set_window_rows(uint16_t ys, uint16_t ye)
+{
+    set_row_address(ys, ye);
+    start_write_memory();
+}
+
+
+//ˮƽγ: һ len x 1 Ĵںдlen
+void lcd_draw_hline(uint16_t x, uint16_t y, uint16_t len, uint16_t color)
+{
+    if (len == 0)
+        return;
+    lcd_fill(x, y, x + len - 1, y, color);
+}
+
+//ֱγ: һ 1 x len Ĵںдlen
+void lcd_draw_vline(uint16_t x, uint16_t y, uint16_t len, uint16_t color)
+{
+    if (len == 0)
+        return;
+    lcd_fill(x, y, x, y + len - 1, color);
+}
+
+
 void lcd_clear(uint16_t color)
 {
    lcd_fill(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1, color);
@@ -527,55 +563,116 @@ uint16_t lcd_read_point(uint16_t x, uint16_t y)
 }
 
 
-void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+//ü,  lcd_draw_line_clip úγʹ
+static int clip_xmin, clip_ymin, clip_xmax, clip_ymax;
+
+//ˮƽγ [xa,xb] (˳), üǰ
+static void line_hrun(int xa, int xb, int y, uint16_t color)
+{
+	int t;
+	if(y < clip_ymin || y > clip_ymax)
+		return;
+	if(xa > xb) { t = xa; xa = xb; xb = t; }
+	if(xa < clip_xmin) xa = clip_xmin;
+	if(xb > clip_xmax) xb = clip_xmax;
+	if(xa <= xb)
+		lcd_draw_hline(xa, y, xb - xa + 1, color);
+}
+
+//ֱγ [ya,yb] (˳), üǰ
+static void line_vrun(int x, int ya, int yb, uint16_t color)
+{
+	int t;
+	if(x < clip_xmin || x > clip_xmax)
+		return;
+	if(ya > yb) { t = ya; ya = yb; yb = t; }
+	if(ya < clip_ymin) ya = clip_ymin;
+	if(yb > clip_ymax) yb = clip_ymax;
+	if(ya <= yb)
+		lcd_draw_vline(x, ya, yb - ya + 1, color);
+}
+
+//Bresenham, γü [xmin,xmax] x [ymin,ymax]:
+//ΪXʱ, ͬһϵغϲΪһˮƽγ, ֻһδ;
+//ΪYʱͬϲΪֱγ. ˮƽ/ֱ˻Ϊγ.
+//üÿγ, Ҫ󽻵, ûг.
+void lcd_draw_line_clip(int x1, int y1, int x2, int y2, uint16_t color,
+                        int xmin, int ymin, int xmax, int ymax)
 {
-	uint16_t t;
-	int xerr=0,yerr=0,delta_x,delta_y,distance;
-	int incx,incy,uRow,uCol;
+	int delta_x,delta_y,err;
+	int incx,incy,uRow,uCol,run_start;
 	
-	//Խж
-	if(x1 > LCD_WIDTH)
-		x1 = LCD_WIDTH;
-	if(x2 > LCD_WIDTH)
-		x2 = LCD_WIDTH;
-	if(y1 > LCD_HEIGHT)
-		y1 = LCD_HEIGHT;
-	if(y2 > LCD_HEIGHT)
-		y2 = LCD_HEIGHT;
+	//˵ڲüͬһ֮, ߲ɼ
+	if((x1 < xmin && x2 < xmin) || (x1 > xmax && x2 > xmax) ||
+	   (y1 < ymin && y2 < ymin) || (y1 > ymax && y2 > ymax))
+		return;
+	clip_xmin = xmin; clip_ymin = ymin;
+	clip_xmax = xmax; clip_ymax = ymax;
 	
 	delta_x=x2-x1; //
 	delta_y=y2-y1;
+	incx=1;        //õ
+	if(delta_x<0) {incx=-1;delta_x=-delta_x;}
+	incy=1;
+	if(delta_y<0) {incy=-1;delta_y=-delta_y;}
 	uRow=x1;
 	uCol=y1;
-	if(delta_x>0)
-		incx=1;  //õ
-	else if(delta_x==0)
-		incx=0;  //ֱ
-	else {incx=-1;delta_x=-delta_x;}
-	if(delta_y>0)
-		incy=1;
-	else if(delta_y==0)
-		incy=0;  //ˮƽ
-	else {incy=-1;delta_y=-delta_y;}
-	if(delta_x>delta_y)
-		distance=delta_x;         //ѡȡ
-	else distance=delta_y;
-	for(t=0;t<=distance+1;t++ )    //
+	
+	if(delta_x>=delta_y)
 	{
-		lcd_draw_point(uRow,uCol,color); //
-		xerr+=delta_x ;
-		yerr+=delta_y ;
-		if(xerr>distance){
-			 xerr-=distance;
-			 uRow+=incx;
+		//XΪ: ÿYʱǰеγ
+		err=delta_x>>1;
+		run_start=uRow;
+		while(uRow!=x2)
+		{
+			err-=delta_y;
+			if(err<0)
+			{
+				line_hrun(run_start, uRow, uCol, color);
+				err+=delta_x;
+				uCol+=incy;
+				run_start=uRow+incx;
+			}
+			uRow+=incx;
 		}
-		if(yerr>distance){
-			 yerr-=distance;
-			 uCol+=incy;
+		line_hrun(run_start, uRow, uCol, color);
+	}
+	else
+	{
+		//YΪ: ÿXʱǰеγ
+		err=delta_y>>1;
+		run_start=uCol;
+		while(uCol!=y2)
+		{
+			err-=delta_x;
+			if(err<0)
+			{
+				line_vrun(uRow, run_start, uCol, color);
+				err+=delta_y;
+				uRow+=incx;
+				run_start=uCol+incy;
+			}
+			uCol+=incy;
 		}
+		line_vrun(uRow, run_start, uCol, color);
 	}
 }
 
+void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
+{
+	//Խж
+	if(x1 >= LCD_WIDTH)
+		x1 = LCD_WIDTH - 1;
+	if(x2 >= LCD_WIDTH)
+		x2 = LCD_WIDTH - 1;
+	if(y1 >= LCD_HEIGHT)
+		y1 = LCD_HEIGHT - 1;
+	if(y2 >= LCD_HEIGHT)
+		y2 = LCD_HEIGHT - 1;
+	
+	lcd_draw_line_clip(x1, y1, x2, y2, color, 0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+}
+
 void lcd_draw_bline(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color)
 {
 	uint16_t i,j;
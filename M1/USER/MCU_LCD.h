@@ -13,9 +13,37 @@ typedef struct
 
 #define LCD	((LCD_TypeDef *) AHB_M1)
 
-#define mpu_write_cmd(reg)		LCD->LCD_REG = reg
-#define mpu_write_data(data)	LCD->LCD_RAM = data
+// LCD: ʱ LCD_BUS_STAT , ÿ/д,
+// ڱȽϲͬͼʽÿ֡AHBд. δʱκο.
+#ifdef LCD_BUS_STAT
+typedef struct
+{
+    uint32_t cmd_writes;   // mpu_write_cmd 
+    uint32_t data_writes;  // mpu_write_data 
+} LCD_Bus_Stat_t;
+
+extern LCD_Bus_Stat_t lcd_bus_stat;
+void lcd_bus_stat_reset(void);
+
+#define LCD_BUS_CMD_INC()		(lcd_bus_stat.cmd_writes++)
+#define LCD_BUS_DATA_INC()		(lcd_bus_stat.data_writes++)
+#define LCD_BUS_TOTAL()			(lcd_bus_stat.cmd_writes + lcd_bus_stat.data_writes)
+#else
+#define LCD_BUS_CMD_INC()		((void)0)
+#define LCD_BUS_DATA_INC()		((void)0)
+#endif
+
+#ifdef LCD_HOST_MODEL
+//  (M1/HOST): ߷ת NT35510 ģ
+#include "nt35510_model.h"
+#define mpu_write_cmd(reg)		(LCD_BUS_CMD_INC(), nt35510_write_cmd(reg))
+#define mpu_write_data(data)	(LCD_BUS_DATA_INC(), nt35510_write_data(data))
+#define mpu_read_data()			nt35510_read_data()
+#else
+#define mpu_write_cmd(reg)		(LCD_BUS_CMD_INC(), LCD->LCD_REG = (reg))
+#define mpu_write_data(data)	(LCD_BUS_DATA_INC(), LCD->LCD_RAM = (data))
 #define mpu_read_data()			LCD->LCD_RAM
+#endif
 
 /* LCDߴ */
 #define LCD_WIDTH	800
@@ -106,7 +134,13 @@ void lcd_draw_point(uint16_t x, uint16_t y, uint16_t color);
 uint16_t lcd_read_point(uint16_t x, uint16_t y);
 void lcd_draw_bline(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 void lcd_fill(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye, uint16_t color);
+void lcd_set_window(uint16_t xs, uint16_t ys, uint16_t xe, uint16_t ye);
+void lcd_set_window_rows(uint16_t ys, uint16_t ye);
+void lcd_draw_hline(uint16_t x, uint16_t y, uint16_t len, uint16_t color);
+void lcd_draw_vline(uint16_t x, uint16_t y, uint16_t len, uint16_t color);
 void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
+void lcd_draw_line_clip(int x1, int y1, int x2, int y2, uint16_t color,
+                        int xmin, int ymin, int xmax, int ymax);
 void lcd_draw_bline(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 void lcd_draw_rectangle(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t color);
 void lcd_show_pic(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *pic);
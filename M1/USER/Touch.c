@@ -13,6 +13,9 @@
 **/
 
 #include "Touch.h"
+#include "i2c_async.h"
+#include "systime.h"
+#include "prof.h"
 /******** XY귽 ********
 
 X(0~800)
@@ -25,12 +28,12 @@ Y
 
 *********************************/
 Touch_Data Touch_LCD;
-uint16_t tp_x[5];        //ǰ
-uint16_t tp_y[5];
-uint16_t tp_sta;
-const uint16_t GT1151_TPX_TBL[5]= {GT_TP1_REG,GT_TP2_REG,GT_TP3_REG,GT_TP4_REG,GT_TP5_REG};
 
-static void delay_ms(__IO uint32_t nCount);
+//첽ȡõĻʹ
+static uint8_t tp_report[6];
+static uint8_t tp_zero = 0;
+static I2C_Xfer_t tp_read_xfer;
+static I2C_Xfer_t tp_clear_xfer;
 
 /***************GT1151ò***************/
 const uint8_t GT1151_CFG_TBL[236]= {
@@ -67,91 +70,21 @@ const uint8_t GT1151_CFG_TBL[236]= {
 };
 
 
+//дĴ: ж I2C , ˯ߵȴ (ʼʱʹ)
 void GT1151_WR_Reg(uint16_t Reg_Addr, uint8_t *Buff, uint16_t Len)
 {
-	uint32_t i;
-	
-	I2C->TXR = SLAVE_DEV_ADDR;
-	I2C->CR = I2C_CMD_STA|I2C_CMD_WR;
-	while(I2C->SR&I2C_SR_TIP);//wait TIP
-	while(I2C->SR&I2C_SR_RXACK);//wait ack-----Over Here
-
-	//8λ
-	I2C->TXR = Reg_Addr >> 8;
-	I2C->CR = (I2C_CMD_WR);
-	while(I2C->SR&I2C_SR_TIP);//wait TIP
-	while(I2C->SR&I2C_SR_RXACK);//wait ack
-	
-	//8λ
-	I2C->TXR = Reg_Addr & 0xFF;	
-	I2C->CR = (I2C_CMD_WR);
-	while(I2C->SR&I2C_SR_TIP);//wait TIP
-	while(I2C->SR&I2C_SR_RXACK);//wait ack
-	
-	for(i=0;i<Len;i++)
-	{
-		I2C->TXR = Buff[i];
-		if((Len-1) == i)
-		{
-			I2C->CR = (I2C_CMD_STO|I2C_CMD_WR);
-		}
-		else
-		{
-			I2C->CR = (I2C_CMD_WR);
-		}
-		
-		while(I2C->SR&I2C_SR_TIP);//wait TIP
-		while(I2C->SR&I2C_SR_RXACK);//wait ack
-	}
-	
-	while(I2C->SR&I2C_SR_BUSY);
-	Delay_ms_i2c(3);//Wait the data to I2C Ready
+	I2C_Xfer_t x;
 	
+	I2C_Xfer_Setup(&x, SLAVE_DEV_ADDR, Reg_Addr, Buff, Len, 0, 0);
+	I2C_Xfer_Run(&x);	//д 3ms һʴǰ֤
 }
 
 void GT1151_RD_Reg(uint16_t Reg_Addr, uint8_t *Buff, uint16_t Len)
 {
-	uint32_t i;
-	
-	I2C->TXR = SLAVE_DEV_ADDR;
-	I2C->CR = I2C_CMD_STA|I2C_CMD_WR;	
-	while(I2C->SR&I2C_SR_TIP);
-	while(I2C->SR&I2C_SR_RXACK);//wait ack-----Over Here
-	
-	//8λ
-	I2C->TXR = Reg_Addr >> 8;	
-	I2C->CR = (I2C_CMD_WR);
-	while(I2C->SR&I2C_SR_TIP);//wait TIP
-	while(I2C->SR&I2C_SR_RXACK);//wait ack
-	
-	//8λ
-	I2C->TXR = Reg_Addr & 0xFF;	
-	I2C->CR = (I2C_CMD_WR);
-	while(I2C->SR&I2C_SR_TIP);//wait TIP
-	while(I2C->SR&I2C_SR_RXACK);//wait ack
-
-	I2C->TXR = SLAVE_DEV_ADDR | 0x01;	
-	I2C->CR = (I2C_CMD_STA|I2C_CMD_WR);
-	while(I2C->SR&I2C_SR_TIP);
-	while(I2C->SR&I2C_SR_RXACK);//wait ack	
-	
-	for(i=0;i<Len;i++)
-	{
-		if((Len-1) == i)
-		{
-			I2C->CR = (I2C_CMD_ACK|I2C_CMD_STO|I2C_CMD_RD);//send nack
-		}
-		else
-		{
-			I2C->CR = (~I2C_CMD_ACK&I2C_CMD_RD);//send ack
-		}
-		
-		while(I2C->SR&I2C_SR_TIP);
-		Buff[i] = I2C->RXR;
-	}
-	
-	while(I2C->SR&I2C_SR_BUSY);
+	I2C_Xfer_t x;
 	
+	I2C_Xfer_Setup(&x, SLAVE_DEV_ADDR, Reg_Addr, Buff, Len, 1, 0);
+	I2C_Xfer_Run(&x);
 }
 
 /**
@@ -194,11 +127,12 @@ void GT1151_Init(void)
     uint8_t buff[1];
 
     TP_IIC_Init(100);	//ʼI2C,ƵΪ400K
+    I2C_Async_Init();	//I2Cж, ֮Ķджƽ
 
     TP_RST_LOW;			//RSTΪ0λ
-    delay_ms(10);		//ʱ10ms
+    Time_Delay_ms(10);		//ʱ10ms
     TP_RST_HIGH;		//RSTΪ1ͷŸλ
-	delay_ms(100);
+	Time_Delay_ms(100);
 
     GT1151_RD_Reg(GT_PID_REG,id,4);		//ȡID
     printf("Touch ID:%s\n",id);				//ӡID
@@ -210,68 +144,75 @@ void GT1151_Init(void)
 		GT1151_Send_Cfg(0);		//õ
 	GT1151_RD_Reg(GT_CFGS_REG,buff,1);		//ȡGT_CFGS_REGĴ
 	printf("Current version: 0x%02X\n",buff[0]);		//ʾǰõİ汾ţA~Z
-	delay_ms(10);		//ʱ10ms
+	Time_Delay_ms(10);		//ʱ10ms
 	buff[0]=0X00;
 	GT1151_WR_Reg(GT_CTRL_REG,buff,1);//λ
+	I2C_Xfer_Setup(&tp_clear_xfer, SLAVE_DEV_ADDR, GT_GSTID_REG, &tp_zero, 1, 0, 0);
 }
 
 /**
   *****************************************************************************
-  * @: ɨ败(ѯʽ)
-  * @ֵTouch_Dataṹ
+  * @:  GT1151 INT ŵ½ж (GPIO0_3_Handler)
+  *            дʱȥ I2C, ÿѭѯ״̬Ĵ
   *****************************************************************************
 **/
-void GT1151_Scan(Touch_Data *Touch_LCD, uint8_t dir)
+void GT1151_INT_Init(void)
 {
-	uint8_t i;
-	uint8_t State = 0;
-	uint8_t Data_XY[4]={0};
-	uint16_t X_Pos,Y_Pos;
-	uint8_t Zero = 0;
+	GPIO0->OUTENCLR   = TP_INT_PIN;		//
+	GPIO0->INTTYPESET = TP_INT_PIN;		//ش
+	GPIO0->INTPOLCLR  = TP_INT_PIN;		//½
+	GPIO0->INTCLEAR   = TP_INT_PIN;		//λڼĹ
+	GPIO0->INTENSET   = TP_INT_PIN;
+	NVIC_EnableIRQ(TP_INT_IRQn);
+}
 
-	Touch_LCD->Touched_Last = Touch_LCD->Touched;//ϴεĴ״̬
-	GT1151_RD_Reg(GT_GSTID_REG,&State,1);	//ȡ״̬Ĵ
-	//λΪ1ʾЧ
-	if(State & 0X80) {
-		Touch_LCD->Touch_Num = State & 0X0F;		//ȡΪ0ʾް
-		//㻻㵽ӦbitΪ1ʾΪ0ʾδ
-		Touch_LCD->Touched = 0x1F >> (5 - Touch_LCD->Touch_Num);
+/**
+  *****************************************************************************
+  * @: 첽ȡһδ ( INT жϺ), 
+  *            һζ״̬Ĵ͵һ (0X814E~0X8153,  6 ֽ),
+  *            Чʱд 0 ״̬Ĵ,  I2C ж done
+  *            ֻõһ,  4 㲻
+  * @ֵTouch_Dataṹ (жϸ), done ΪЧʱĻص
+  *****************************************************************************
+**/
+static Touch_Data *tp_async_data;
+static uint8_t tp_async_dir;
+static void (*tp_async_done)(Touch_Data *Touch_LCD);
 
-		//λȡ
-		if(dir==0){ //
-			for(i=0;i<5;i++) {//for(i=0;i<Touch_LCD->Touch_Num;i++) {
-				GT1151_RD_Reg(GT1151_TPX_TBL[i],Data_XY,4);	//ȡXYֵ
-				X_Pos = Data_XY[3] << 8;
-				X_Pos |= Data_XY[2];
-				Y_Pos = Data_XY[1] << 8;
-				Y_Pos |= Data_XY[0];
-				
-				if(X_Pos <= 480)
-					Touch_LCD->Tp_X[i] = X_Pos;
-				if(Y_Pos <= 800)
-					Touch_LCD->Tp_Y[i] = Y_Pos;
-			}
-		}else{	//
-			for(i=0;i<5;i++) {//for(i=0;i<Touch_LCD->Touch_Num;i++) {
-				GT1151_RD_Reg(GT1151_TPX_TBL[i],Data_XY,4);	//ȡXYֵ
-				X_Pos = Data_XY[3] << 8;
-				X_Pos |= Data_XY[2];
-				Y_Pos = Data_XY[1] << 8;
-				Y_Pos |= Data_XY[0];
-				
-				if(X_Pos <= 800)
-					Touch_LCD->Tp_X[i] = 800 - X_Pos;
-				if(Y_Pos <= 480)
-					Touch_LCD->Tp_Y[i] = Y_Pos;
-			}
-		}
-		GT1151_WR_Reg(GT_GSTID_REG, &Zero, 1);	//д0Ĵһμ
+static void GT1151_Report_Done(I2C_Xfer_t *x)
+{
+	uint8_t State = tp_report[0];
+	uint16_t X_Pos,Y_Pos;
+	Touch_Data *tp = tp_async_data;
+
+	PROF_STOP(PROF_TOUCH_SCAN);
+	if(x->status != I2C_XFER_OK || !(State & 0X80))
+		return;
+	I2C_Submit(&tp_clear_xfer);		//д0Ĵһμ
+
+	tp->Touched_Last = tp->Touched;
+	tp->Touch_Num = State & 0X0F;
+	tp->Touched = 0x1F >> (5 - tp->Touch_Num);
+	X_Pos = (tp_report[5] << 8) | tp_report[4];
+	Y_Pos = (tp_report[3] << 8) | tp_report[2];
+	if(tp_async_dir==0){ //
+		if(X_Pos <= 480) tp->Tp_X[0] = X_Pos;
+		if(Y_Pos <= 800) tp->Tp_Y[0] = Y_Pos;
+	}else{	//
+		if(X_Pos <= 800) tp->Tp_X[0] = 800 - X_Pos;
+		if(Y_Pos <= 480) tp->Tp_Y[0] = Y_Pos;
 	}
+	tp_async_done(tp);
 }
 
-//delay ms
-static void delay_ms(__IO uint32_t nCount)
+uint8_t GT1151_Scan_Async(Touch_Data *Touch_LCD, uint8_t dir, void (*done)(Touch_Data *Touch_LCD))
 {
-	nCount *= 4333;
-	for(; nCount != 0; nCount--);
+	if(tp_read_xfer.status == I2C_XFER_QUEUED || tp_read_xfer.status == I2C_XFER_BUSY)
+		return 0;	//һλû, Ѿ±
+	tp_async_data = Touch_LCD;
+	tp_async_dir  = dir;
+	tp_async_done = done;
+	I2C_Xfer_Setup(&tp_read_xfer, SLAVE_DEV_ADDR, GT_GSTID_REG, tp_report, 6, 1, GT1151_Report_Done);
+	PROF_START(PROF_TOUCH_SCAN);
+	return I2C_Submit(&tp_read_xfer);
 }
@@ -10,6 +10,11 @@
 #define	TP_RST_HIGH	GPIO_SetBit(GPIO0,GPIO_Pin_2)
 #define	TP_RST_LOW	GPIO_ResetBit(GPIO0,GPIO_Pin_2)
 
+//GT1151 INT  GPIO0_3: µĴʱ½ (ñ 7 ֽڵ 2 λ = 01),
+//סڼ䰴ظ, ɿʱٱһ 0 
+#define TP_INT_PIN	GPIO_Pin_3
+#define TP_INT_IRQn	GPIO0_3_IRQn
+
 
 //GT1151üĴ
 #define GT_CTRL_REG     0X8040      //GT1151ƼĴ
@@ -37,7 +42,7 @@ extern Touch_Data Touch_LCD;
 
 uint8_t GT1151_Send_Cfg(uint8_t mode);//GT1151ò
 void GT1151_Init(void);		//ʼGT1151
-void GT1151_Scan(Touch_Data *Touch_LCD, uint8_t dir);//ɨ败
-void delay_ms(__IO uint32_t nCount);
+void GT1151_INT_Init(void);	// INT ж
+uint8_t GT1151_Scan_Async(Touch_Data *Touch_LCD, uint8_t dir, void (*done)(Touch_Data *Touch_LCD));//첽ȡ
 
 #endif /* TOUCH_TOUCH_H_ */
@@ -62,6 +62,57 @@ Button Analog_V_down = {
     24, {"Div/V-"}
 };
 
+// ȡʽл (ʾǰʽ)
+Button Analog_Mode = {
+    {560, 165, 60, 40},
+    LCD_BLACK, LCD_GRAY,
+    24, {"Smp"}
+};
+
+// ťʾĳȡʽ, ˳ ANALOG_DECIM_xxx һ
+const char* ANALOG_MODE_NAMES[ANALOG_MODE_LEVELS] = {
+    "Smp",
+    "Peak",
+    "Avg"
+};
+
+// ʽл (HW/SW  + б, ر); ƽ
+Button Analog_Trig = {
+    {730, 165, 60, 40},
+    LCD_BLACK, LCD_GRAY,
+    24, {"HW+"}
+};
+
+// ťʾĴʽ: ż, ½
+const char* ANALOG_TRIG_NAMES[ANALOG_TRIG_LEVELS] = {
+    "HW+",
+    "HW-",
+    "SW+",
+    "SW-",
+    "Off"
+};
+
+// ʱ (YT)/Ƶ (FFT) ʾл (ʾǰͼ)
+Button Analog_FFT = {
+    {560, 255, 60, 40},
+    LCD_BLACK, LCD_GRAY,
+    24, {"YT"}
+};
+
+// /˫ͨл (ʾǰͨ); ˫̶ͨȡʽ, CH1 ɫ, CH2 ɫ
+Button Analog_CH = {
+    {730, 255, 60, 40},
+    LCD_BLACK, LCD_GRAY,
+    24, {"1CH"}
+};
+
+// 洢: ֹͣԤһ DDR3 ¼, ֮ Time+/- , ƽ
+Button Analog_Deep = {
+    {645, 210, 60, 40},
+    LCD_BLACK, LCD_GRAY,
+    24, {"Deep"}
+};
+
 // ================== ť ==================
 Button Analog_Start = {
     {565, 310, 100, 70},  // X1, Y1, Width, Height
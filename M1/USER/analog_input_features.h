@@ -16,6 +16,15 @@ extern Button Analog_V_up;
 extern Button Analog_Freq_down;
 extern Button Analog_Freq_up ;
 extern Button Analog_V_down ;
+extern Button Analog_Mode ;
+#define ANALOG_MODE_LEVELS 3
+extern const char* ANALOG_MODE_NAMES[ANALOG_MODE_LEVELS];
+extern Button Analog_Trig ;
+#define ANALOG_TRIG_LEVELS 5
+extern const char* ANALOG_TRIG_NAMES[ANALOG_TRIG_LEVELS];
+extern Button Analog_FFT ;
+extern Button Analog_CH ;
+extern Button Analog_Deep ;
 // ================== ť ==================
 extern Button Analog_Start;
 extern Button Analog_Stop ;
@@ -1,9 +1,13 @@
 #include "main.h"
+#include <string.h>
 #include "event_handler.h"
 #include "fpga_registers.h"
 #include "PageDesign.h"
 #include "Touch.h"
 #include "ui_design_handler.h"
+#include "scope_trigger.h"
+#include "scope_measure.h"
+#include "scope_fft.h"
 
 // UIԪصĶ
 #include "Create_Features.h"
@@ -11,6 +15,8 @@
 #include "analog_input_features.h"
 #include "digital_input_features.h"
 #include "usb_cdc_features.h"
+#include "systime.h"
+#include "prof.h"
 
 // ============================================================================
 //  ļUIҳľ¼߼
@@ -18,18 +24,69 @@
 // ============================================================================
 
 // Ϊģҳ洴һصݻ
-static uint8_t waveform_buffer[WAVEFORM_POINTS];
+// ֶ: FPGA ÿִ 4 ֽ, M1 ΪС, ֱӰֿõֽ/16λ˳
+// FPGA д, ֡㲻һֶ: ڵֿʼ 1  (ֱ,
+// ֮ǰֽ֡β), δ waveform_buffer + waveform_offset ʼȡ (offset =  & 3)
+static union {
+    uint8_t  u8[WAVEFORM_POINTS + 4];        // ȡ: 8 λ; ֵ: {min, max} ֽڶ; ˫ͨ: {CH1, CH2} ֽڶ
+    uint16_t u16[WAVEFORM_POINTS / 2 + 2];   // ƽ: Q8.8 
+    uint32_t u32[WAVEFORM_POINTS / 4 + 1];
+} waveform_buffer;
+static uint8_t waveform_offset;             // ֡еֽƫ (0..3)
+// ĻʾĴ (λ: , ֵʽΪֽڶ): Ӳ/Ϊ֡,
+// ʱ FPGA ɼ, ʾԴΪĵİ֡
+static int waveform_view_start = 0;
+static int waveform_view_slots = WAVEFORM_POINTS;
+
+// Ƶͼ: ֡ (ȡʽ 512 , ֵ/ƽʽ 256 )  FFT.
+//  dB ʱ bin д spectrum_re ǰ벿 (bin k д k), 
+static uint8_t spectrum_view = 0;
+static int16_t spectrum_re[SCOPE_FFT_N];
+static int16_t spectrum_im[SCOPE_FFT_N];
+static int     spectrum_bins = 0;           // spectrum_re Ч dB 
+static int     spectrum_peak_bin = 0;
+static int16_t spectrum_peak_db = 0;
+
+// ˫ͨ: FPGA ̶ȡ, ÿ {CH1 (AD0), CH2 (AD1)} ֽڶ, һֺ·.
+// Ϊ waveform_buffer һ "ȡʽ" ; Ƶֻ CH1
+#define ANALOG_ACQ_DUAL (ANALOG_DECIM_MODE_COUNT)
+static uint8_t dual_view = 0;
 
 #define CAPTURE_POINTS 1024
 static uint8_t capture_buffer[CAPTURE_POINTS];
 volatile uint32_t g_debug_word;
-// --- ˵ҳ洦 ---
-void Handle_Main_Page(void)
+volatile uint32_t g_fpga_irq_flags = 0;
+
+// --- FPGA ݾж ---
+void FPGA_IRQ_Init(void)
+{
+    FPGA_IRQ_STATUS_REG = FPGA_IRQ_ALL_Msk;   // ϵǰĹλ
+    g_fpga_irq_flags = 0;
+    FPGA_IRQ_ENABLE_REG = FPGA_IRQ_ALL_Msk;
+    NVIC_EnableIRQ(FPGA_IRQn);
+}
+
+// ȡ߲ mask ѹжλ, ȡλ
+uint32_t FPGA_IRQ_Take(uint32_t mask)
 {
-    static uint8_t touch_processed = 0;
-    GT1151_Scan(&Touch_LCD, 1);
+    uint32_t taken;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    taken = g_fpga_irq_flags & mask;
+    g_fpga_irq_flags &= ~taken;
+    if (!primask) __enable_irq();
+    return taken;
+}
+
+// USB CDC ҳļػ: ֻΪչʾ, ֹʱ첽
+#define USB_CDC_LOADING_MS 1000
+static uint8_t  usb_cdc_loading = 0;
+static uint32_t usb_cdc_ready_at;
 
-    if (Touch_LCD.Touch_Num > 0 && !touch_processed)
+// --- ˵ҳ洦 ---
+void Handle_Main_Page(const Event_t* evt)
+{
+    if (evt->type == EVT_TOUCH)
     {
         // 1. ť
         if (Judge_TpXY(Touch_LCD, Wave_Generate.Box)) {
@@ -56,24 +113,17 @@ void Handle_Main_Page(void)
             MODE_SELECT_REG = MODE_USB_CDC;           
             // 2. () ʾض
             Display_Loading_Screen("USB CDC Module");           
-            // 3. () ʱ (ȴ 1000ms)
-            mcu_sw_delay_ms(1000);            
-            // 4. () յҳ
-            Display_USB_CDC();
+            // 3. ػ汣 1000ms, ʱ USB CDC ҳҳ (ѭ)
+            usb_cdc_loading = 1;
+            usb_cdc_ready_at = Time_Deadline_ms(USB_CDC_LOADING_MS);
         }
-        touch_processed = 1;
-    }
-    else if(Touch_LCD.Touch_Num == 0) {
-        touch_processed = 0;
     }
 }
 
 
 // --- ҳ洦  ---
-void Handle_Wave_Out_Page(void)
+void Handle_Wave_Out_Page(const Event_t* evt)
 {
-    static uint8_t touch_processed = 0;
-    
     // ʹþ̬״̬
     static uint32_t wave_type = WAVE_TYPE_SINE;
     static uint32_t freq_code = FREQ_1_25K;
@@ -83,9 +133,7 @@ void Handle_Wave_Out_Page(void)
     // ״̬־0=ֹͣ, 1=
     static uint8_t is_running = 0;
 
-    GT1151_Scan(&Touch_LCD, 1);
-
-    if (Touch_LCD.Touch_Num > 0 && !touch_processed)
+    if (evt->type == EVT_TOUCH)
     {
         // --- ȴȼť ---
         if (Judge_TpXY(Touch_LCD, Out_Exit.Box)) {
@@ -93,7 +141,6 @@ void Handle_Wave_Out_Page(void)
             currentPage = PAGE_MAIN;
             MODE_SELECT_REG = MODE_EXIT_TO_MAIN;
             Display_Main_board();
-            touch_processed = 1; // ڷǰñ־
             return;
         }
         
@@ -173,11 +220,6 @@ void Handle_Wave_Out_Page(void)
                 }
             }
         }
-
-        touch_processed = 1;
-    }
-    else if (Touch_LCD.Touch_Num == 0) {
-        touch_processed = 0;
     }
 }
 
@@ -201,34 +243,623 @@ const int time_div_max_index = (sizeof(time_div_options_us)/sizeof(uint32_t)) -
 
 const uint16_t v_div_options_mv[]  = {100, 200, 500, 1000, 2000}; // 100mV, 200mV, 500mV, 1V, 2V
 
+// ʽ (Analog_Trig ť): λѡԴ, λѡб
+#define ANALOG_TRIG_SRC(idx)      ((idx) >> 1)
+#define ANALOG_TRIG_IS_FALLING(idx) ((idx) & 1)
+enum {
+    ANALOG_TRIG_SRC_HW,      // FPGA Ӳ (Զʽ), ֡ʾ
+    ANALOG_TRIG_SRC_SW,      //  (淽ʽ): ֻʾ֡
+    ANALOG_TRIG_SRC_OFF      // 
+};
+
+// ʽ: һ֡Ҫ 100ms ϵʱٵ֡, FPGA һֱд, M1  ANALOG_ROLL_POS
+// ֻдĵ, ҶĻ, , ӳٴһ֡һˢ.
+// waveform_buffer ʱ˳Ļϵһ (offset Ϊ 0). Ƶͼ԰֡ɼ
+#define ANALOG_ROLL_MIN_US   (10000)  // 10ms/div 
+#define ANALOG_ROLL_GUARD    (16)     // һȡ (һ - 16) ,  FPGA Ҫǵλ
+static uint8_t  roll_active = 0;
+static uint8_t  roll_sync = 0;        // 1: һζֻΪ
+static uint16_t roll_count = 0;       // Ѷĵ ( FPGA ͬ)
+static uint32_t roll_decim = 0;       // ǰõĳȡĴֵ
+static int      roll_meas_slots = 0;  // ϴβĵ
+
+static int Analog_Is_Roll(int time_div_index)
+{
+    return time_div_options_us[time_div_index] >= ANALOG_ROLL_MIN_US && !spectrum_view;
+}
+
+// ʵʲɼõķʽ: ˫ͨʱѡĳȡʽ
+static uint8_t Analog_Acq_Mode(uint8_t decim_mode)
+{
+    return dual_view ? ANALOG_ACQ_DUAL : decim_mode;
+}
+
+// дȡĴ: ʱӦ N ͳȡʽ; ʱ N ӱ, һ֡ (ʽ).
+// ˫ͨÿ N дһ (һ֡ 256 ), N Ҳӱ, ʹһ֡ǵʱ뵥ͨͬ.
+// дֵ
+static uint32_t Analog_Write_Decim(int time_div_index, uint8_t mode, uint8_t trig_index)
+{
+    uint32_t n = time_div_decim_cnt[time_div_index];
+    uint32_t reg;
+
+    if (Analog_Is_Roll(time_div_index)) {
+        reg = ANALOG_DECIM_ROLL_Msk;
+    } else {
+        reg = 0;
+        if (ANALOG_TRIG_SRC(trig_index) == ANALOG_TRIG_SRC_SW) n <<= 1;
+    }
+    if (mode == ANALOG_ACQ_DUAL) {
+        n <<= 1;
+        reg |= ANALOG_DECIM_DUAL_Msk;
+        mode = ANALOG_DECIM_SAMPLE;
+    }
+    reg |= (n << ANALOG_DECIM_N_Pos) | ((uint32_t)mode << ANALOG_DECIM_MODE_Pos);
+    ANALOG_DECIM_REG = reg;
+    return reg;
+}
+
+// дĴ: Ԥȡ֡, Ļ; Զʽ֤ûźʱҲв.
+// ʱرӲ, FPGA  0 ˳д
+#define ANALOG_TRIG_LEVEL_DEFAULT (128)   // ADC ֵ 128 = 0V
+#define ANALOG_TRIG_HYST_DEFAULT  (4)
+#define ANALOG_TRIG_PRE_DEFAULT   (WAVEFORM_POINTS / 2)
+#define ANALOG_SOFT_HOLDOFF       (8)     //  ()
+static void Analog_Write_Trig(uint8_t trig_index, uint8_t level)
+{
+    uint32_t reg = ((uint32_t)level << ANALOG_TRIG_LEVEL_Pos)
+                 | ((uint32_t)ANALOG_TRIG_HYST_DEFAULT << ANALOG_TRIG_HYST_Pos)
+                 | ((uint32_t)ANALOG_TRIG_PRE_DEFAULT << ANALOG_TRIG_PRE_Pos)
+                 | (ANALOG_TRIG_IS_FALLING(trig_index) ? ANALOG_TRIG_FALLING_Msk : 0);
+
+    if (ANALOG_TRIG_SRC(trig_index) == ANALOG_TRIG_SRC_HW)
+        reg |= ANALOG_TRIG_EN_Msk | ANALOG_TRIG_AUTO_Msk;
+    ANALOG_TRIG_REG = reg;
+}
+
+// ʱ (ns): ֵ/ƽʽһ 2N  ADC  (˫ͨ N ӱ, ͬ),
+// ʱ N ӱ (ʽ)
+static uint32_t Analog_Slot_ns(int time_div_index, uint8_t mode, uint8_t trig_index)
+{
+    uint32_t ns = time_div_decim_cnt[time_div_index] * ADC_SAMPLE_NS;
+
+    if (mode != ANALOG_DECIM_SAMPLE) ns <<= 1;
+    if (ANALOG_TRIG_SRC(trig_index) == ANALOG_TRIG_SRC_SW && !Analog_Is_Roll(time_div_index)) ns <<= 1;
+    return ns;
+}
+
+// : ڸն֡ () Ҵ, ҵʾڶΪĵİ֡.
+// ֻ [/2, /2 + ) , ֤඼.  1 ʾ
+static int Analog_Soft_Trigger(uint8_t mode, uint8_t trig_index, uint8_t level)
+{
+    const uint8_t* wave = waveform_buffer.u8 + waveform_offset;
+    int slots = (mode == ANALOG_DECIM_SAMPLE) ? WAVEFORM_POINTS : WAVEFORM_POINTS / 2;
+    int stride = 1;
+    int window = slots >> 1;
+    int pre = window >> 1;
+    int t;
+    Scope_Trigger trig;
+
+    trig.level   = level;
+    trig.hyst    = ANALOG_TRIG_HYST_DEFAULT;
+    trig.falling = ANALOG_TRIG_IS_FALLING(trig_index);
+    trig.holdoff = ANALOG_SOFT_HOLDOFF;
+
+    if (mode == ANALOG_DECIM_PEAK) {
+        stride = 2;
+        if (!trig.falling) wave++;          // ؿ max, ½ؿ min (Ӳһ)
+    } else if (mode == ANALOG_DECIM_AVG) {
+        stride = 2;
+        wave++;                             // Q8.8 
+    } else if (mode == ANALOG_ACQ_DUAL) {
+        stride = 2;                         // CH1
+    }
+
+    t = Scope_Trigger_Find(wave, slots, stride, pre, pre + window, &trig);
+    if (t < 0) return 0;
+
+    waveform_view_start = t - pre;
+    waveform_view_slots = window;
+    return 1;
+}
+
+// һ bytes ֽ (ӵֽ) ȡʽ
+static inline void Analog_Meas_Word(Scope_Meas* m, uint8_t mode, uint32_t w, int bytes)
+{
+    if (mode == ANALOG_DECIM_SAMPLE) {
+        for (; bytes > 0; bytes--, w >>= 8)
+            Scope_Meas_Add(m, ((int32_t)(w & 0xFF) - 128) << 4);
+    } else if (mode == ANALOG_DECIM_PEAK) {
+        for (; bytes > 0; bytes -= 2, w >>= 16) {
+            int32_t lo = ((int32_t)(w & 0xFF) - 128) << 4;
+            int32_t hi = ((int32_t)((w >> 8) & 0xFF) - 128) << 4;
+            Scope_Meas_Add_Span(m, lo, hi, (lo + hi) >> 1);   // /ֵֵ
+        }
+    } else if (mode == ANALOG_ACQ_DUAL) {
+        for (; bytes > 0; bytes -= 2, w >>= 16)
+            Scope_Meas_Add(m, ((int32_t)(w & 0xFF) - 128) << 4);  // CH1
+    } else {
+        for (; bytes > 0; bytes -= 2, w >>= 16)
+            Scope_Meas_Add(m, ((int32_t)(w & 0xFFFF) - 32768) >> 4);
+    }
+}
+
+// ѷһ֡:  TRIG_POS ֡ת, ֶ (128 ߶),
+// ͬһѭﰴʱ˳ۼӲ, ֻһ
+static void Analog_Read_Frame(uint8_t mode, Scope_Meas* meas)
+{
+    uint32_t start = (ANALOG_TRIG_POS_REG & ANALOG_TRIG_POS_START_Msk) >> ANALOG_TRIG_POS_START_Pos;
+    uint32_t word  = start >> 2;
+    int      off   = (int)(start & 3);
+    uint32_t w;
+
+    PROF_START(PROF_ANALOG_COPY);
+    Scope_Meas_Begin(meas);
+
+    // : ֮ǰֽ֡β, ټ
+    w = ANALOG_DATA_WORDS[word];
+    waveform_buffer.u32[0] = w;
+    Analog_Meas_Word(meas, mode, w >> (8 * off), 4 - off);
+
+    for (int i = 1; i < ANALOG_DATA_WORD_COUNT; i++) {
+        w = ANALOG_DATA_WORDS[(word + i) & (ANALOG_DATA_WORD_COUNT - 1)];
+        waveform_buffer.u32[i] = w;
+        Analog_Meas_Word(meas, mode, w, 4);
+    }
+
+    // ֡β: ֮ǰֽ, ٶһ
+    w = waveform_buffer.u32[0];
+    waveform_buffer.u32[ANALOG_DATA_WORD_COUNT] = w;
+    Analog_Meas_Word(meas, mode, w, off);
+
+    waveform_offset = (uint8_t)off;
+    PROF_STOP(PROF_ANALOG_COPY);
+}
+
+// ֡ FFT,  (dB)  spectrum_re[0 .. n/2), ͬʱҳ׷.
+// 㻻 0V Ϊ Q15: 8 λ 8 λ, Q8.8 ֱӼ 32768, ֵʽȡ {min,max} ֵ,
+// ˫ͨȡ CH1.
+// ص n (bin  = 1 / (n * ))
+static int Analog_Spectrum(uint8_t mode)
+{
+    const uint8_t* wave = waveform_buffer.u8 + waveform_offset;
+    int log2n = (mode == ANALOG_DECIM_SAMPLE) ? SCOPE_FFT_LOG2N : SCOPE_FFT_LOG2N - 1;
+    int n = 1 << log2n;
+    int k;
+
+    if (mode == ANALOG_DECIM_SAMPLE) {
+        for (k = 0; k < n; k++)
+            spectrum_re[k] = (int16_t)(((int32_t)wave[k] - 128) << 8);
+    } else if (mode == ANALOG_DECIM_PEAK) {
+        for (k = 0; k < n; k++)
+            spectrum_re[k] = (int16_t)((((int32_t)wave[2 * k] + wave[2 * k + 1]) << 7) - 32768);
+    } else if (mode == ANALOG_ACQ_DUAL) {
+        for (k = 0; k < n; k++)
+            spectrum_re[k] = (int16_t)(((int32_t)wave[2 * k] - 128) << 8);
+    } else {
+        const uint16_t* q8 = waveform_buffer.u16 + waveform_offset / 2;
+        for (k = 0; k < n; k++) {
+            int32_t v = (int32_t)q8[k] - 32768;
+            spectrum_re[k] = (int16_t)((v > 32767) ? 32767 : v);
+        }
+    }
+    for (k = 0; k < n; k++) spectrum_im[k] = 0;
+
+    Scope_FFT_Window(spectrum_re, log2n);
+    Scope_FFT_Q15(spectrum_re, spectrum_im, log2n);
+
+    // ֱ Hann й© bin 1, ׷ bin 2 ʼ
+    spectrum_peak_bin = 0;
+    spectrum_peak_db = -9999;
+    for (k = 0; k < n / 2; k++) {
+        uint32_t p = (uint32_t)((int32_t)spectrum_re[k] * spectrum_re[k] +
+                                (int32_t)spectrum_im[k] * spectrum_im[k]);
+        int16_t db = Scope_FFT_Power_dB(p);
+        spectrum_re[k] = db;
+        if (k >= 2 && db > spectrum_peak_db) {
+            spectrum_peak_db = db;
+            spectrum_peak_bin = k;
+        }
+    }
+    spectrum_bins = n / 2;
+    return n;
+}
+
+// ʽ¿ʼ: Ļ 0V, һζΪ
+static void Analog_Roll_Reset(uint8_t mode)
+{
+    waveform_offset = 0;
+    waveform_view_start = 0;
+    waveform_view_slots = (mode == ANALOG_DECIM_SAMPLE) ? WAVEFORM_POINTS : WAVEFORM_POINTS / 2;
+    if (mode == ANALOG_DECIM_AVG) {
+        for (int i = 0; i < WAVEFORM_POINTS / 2; i++) waveform_buffer.u16[i] = 0x8000;
+    } else {
+        memset(waveform_buffer.u8, 128, WAVEFORM_POINTS);
+    }
+    roll_sync = 1;
+    roll_meas_slots = 0;
+}
+
+// дĳȡĴֵ/˳ʽ. FPGA ֻڳȡñ仯 () ʱ 0 ¼,
+// ֻ V/divƽʱŹ, Ļϵʷ
+static void Analog_Roll_Setup(uint32_t decim, uint8_t mode, uint8_t restart)
+{
+    roll_active = (decim & ANALOG_DECIM_ROLL_Msk) != 0;
+    if (roll_active && (restart || decim != roll_decim))
+        Analog_Roll_Reset(mode);
+    roll_decim = decim;
+}
+
+//  FPGA дĵ, ҶĻ, ĵ.
+// ֻµڵ (ÿһ߶), ٶ 512 ֽ
+static int Analog_Roll_Read(uint8_t mode)
+{
+    const int step  = (mode == ANALOG_DECIM_SAMPLE) ? 1 : 2;
+    const int slots = WAVEFORM_POINTS / step;
+    uint16_t count = (uint16_t)((ANALOG_ROLL_POS_REG & ANALOG_ROLL_POS_COUNT_Msk) >> ANALOG_ROLL_POS_COUNT_Pos);
+    int fresh, bytes, addr;
+    uint8_t* dst;
+    uint32_t w = 0;
+
+    // ú FPGA  (λͬʱ仯), ζֻΪ
+    if (roll_sync) {
+        roll_sync = 0;
+        roll_count = count;
+        return 0;
+    }
+    fresh = (uint16_t)(count - roll_count);
+    if (fresh == 0) return 0;
+    if (fresh > slots - ANALOG_ROLL_GUARD) {
+        // ˢ: ֻȡµĲ
+        roll_count = (uint16_t)(count - (slots - ANALOG_ROLL_GUARD));
+        fresh = slots - ANALOG_ROLL_GUARD;
+    }
+
+    bytes = fresh * step;
+    memmove(waveform_buffer.u8, waveform_buffer.u8 + bytes, WAVEFORM_POINTS - bytes);
+    dst  = waveform_buffer.u8 + WAVEFORM_POINTS - bytes;
+    addr = (roll_count * step) & (WAVEFORM_POINTS - 1);
+    for (int i = 0; i < bytes; i++, addr = (addr + 1) & (WAVEFORM_POINTS - 1)) {
+        if (i == 0 || (addr & 3) == 0)
+            w = ANALOG_DATA_WORDS[addr >> 2] >> (8 * (addr & 3));
+        dst[i] = (uint8_t)w;
+        w >>= 8;
+    }
+
+    roll_count = (uint16_t)(roll_count + fresh);
+    roll_meas_slots += fresh;
+    return fresh;
+}
+
+// ʽĲ: Ļϵһһ (֡ʽڶ֡ѭ˳)
+static void Analog_Roll_Measure(uint8_t mode, Scope_Meas* meas)
+{
+    Scope_Meas_Begin(meas);
+    for (int i = 0; i < ANALOG_DATA_WORD_COUNT; i++)
+        Analog_Meas_Word(meas, mode, waveform_buffer.u32[i], 4);
+}
+
+// ˢµ (); Ƶͼµлһ֡׷
+static void Analog_Show_Measure(Scope_Meas* meas, int v_div_index, int time_div_index,
+                                uint8_t mode, uint8_t trig_index, uint8_t* page)
+{
+    Scope_Meas_Result r;
+    uint32_t slot_ns = Analog_Slot_ns(time_div_index, mode, trig_index);
+
+    Scope_Meas_Finish(meas, &r);
+    Update_Analog_Measure(&r, v_div_options_mv[v_div_index], time_div_options_us[time_div_index],
+                          slot_ns, spectrum_view ? ANALOG_MEAS_PAGES : *page);
+    if (spectrum_view && spectrum_bins > 0)
+        Update_Analog_Peak(spectrum_peak_bin, spectrum_peak_db, spectrum_bins * 2, slot_ns);
+    *page = (*page + 1) % ANALOG_MEAS_PAGES;
+}
+
+// : START|ACK -> START. ACK  READY ͷŵǰ bank, FPGA һдһ bank
+static void Analog_Ack_Frame(void)
+{
+    #if defined(__arm__) || defined(__ARM_ARCH)
+    uint32_t __primask = __get_PRIMASK();
+    __disable_irq();               // ٽȷд벻ᱻжϴ
+    #endif
+
+    // һдSTART|ACK
+    ANALOG_CONTROL_REG =
+        (1U << ANALOG_CTRL_START_STOP_Pos) |
+        (1U << ANALOG_CTRL_ACK_DATA_Pos);
+
+    // ܹϣѡ
+    #if defined(__arm__) || defined(__ARM_ARCH)
+    __DSB(); __ISB();
+    #endif
+
+    // ڶд STARTACK  0
+    ANALOG_CONTROL_REG = (1U << ANALOG_CTRL_START_STOP_Pos);
+
+    #if defined(__arm__) || defined(__ARM_ARCH)
+    if (!__primask) __enable_irq();
+    #endif
+}
+
+// ֡/ӳٵʾ (): ÿ 0.5s  FPGA ͳƼĲֵˢ±,
+// һΪ֡ʺһ֡ READY -> ACK ӳ, ڶΪʱڶ֡ ADC .
+//  FPGA , ռȾѭʱ; ʽ֡, ֡Ϊ 0
+#define ANALOG_STATS_PERIOD (FPGA_HCLK_HZ / 2)
+static uint8_t  stats_view = 0;
+static uint32_t stats_ticks, stats_frames, stats_drops, stats_discard;
+
+static void Analog_Stats_Snapshot(void)
+{
+    stats_ticks   = FPGA_STAT_TICKS_REG;
+    stats_frames  = ANALOG_STAT_FRAMES_REG;
+    stats_drops   = ANALOG_STAT_DROPS_REG & ANALOG_STAT_DROPS_Msk;
+    stats_discard = ANALOG_STAT_DISCARD_REG;
+}
+
+// /رյʾ, رʱָ
+static void Analog_Stats_Show(uint8_t on)
+{
+    stats_view = on;
+    if (on) {
+        Analog_Stats_Snapshot();
+        sprintf(Analog_Title.Text[0], "%s", "-- fps");
+    } else {
+        sprintf(Analog_Title.Text[0], "%s", "*** Analog in ***");
+    }
+    Analog_Title.Text[1][0] = '\0';
+    Draw_Normal_Button(Analog_Title);
+}
+
+static void Analog_Stats_Update(void)
+{
+    uint32_t ticks = FPGA_STAT_TICKS_REG;
+    uint32_t ms, fps10, lat_us, drops, discard_k;
+
+    if (ticks - stats_ticks < ANALOG_STATS_PERIOD) return;
+
+    ms        = (ticks - stats_ticks) / (FPGA_HCLK_HZ / 1000);
+    fps10     = (ANALOG_STAT_FRAMES_REG - stats_frames) * 10000 / ms;
+    lat_us    = ANALOG_STAT_ACK_LAT_REG / (FPGA_HCLK_HZ / 1000000);
+    drops     = ((ANALOG_STAT_DROPS_REG & ANALOG_STAT_DROPS_Msk) - stats_drops) & ANALOG_STAT_DROPS_Msk;
+    discard_k = (ANALOG_STAT_DISCARD_REG - stats_discard) / 1000;
+
+    sprintf(Analog_Title.Text[0], "%lu.%lu fps  ack %lu.%02lu ms",
+            (unsigned long)(fps10 / 10), (unsigned long)(fps10 % 10),
+            (unsigned long)(lat_us / 1000), (unsigned long)(lat_us % 1000 / 10));
+    sprintf(Analog_Title.Text[1], "drop %lu  lost %luk smp", (unsigned long)drops, (unsigned long)discard_k);
+    Draw_Normal_Button(Analog_Title);
+    Analog_Stats_Snapshot();
+}
+
+// ݵĳȡʽʾڵĲ (ֵ/ƽʽΪż, һ 16 λ);
+// Ƶͼ»֡Ƶ
+static void Analog_Draw_Buffer(uint8_t mode, uint16_t volts_per_div_mv)
+{
+    uint8_t* wave = waveform_buffer.u8 + waveform_offset;
+
+    if (spectrum_view) {
+        Analog_Spectrum(mode);
+        Draw_Scope_Spectrum(spectrum_re, spectrum_bins, Analog_WaveBoard);
+    } else if (mode == ANALOG_DECIM_PEAK) {
+        Draw_Scope_Envelope(wave + 2 * waveform_view_start, waveform_view_slots, Analog_WaveBoard, volts_per_div_mv);
+    } else if (mode == ANALOG_ACQ_DUAL) {
+        Draw_Scope_Dual(wave + 2 * waveform_view_start, waveform_view_slots, Analog_WaveBoard, volts_per_div_mv);
+    } else if (mode == ANALOG_DECIM_AVG) {
+        Draw_Scope_Waveform16(waveform_buffer.u16 + waveform_offset / 2 + waveform_view_start, waveform_view_slots, Analog_WaveBoard, volts_per_div_mv);
+    } else {
+        Draw_Scope_Waveform(wave + waveform_view_start, waveform_view_slots, Analog_WaveBoard, volts_per_div_mv);
+    }
+}
+
+// 洢 (DDR3): ֹͣԤ,  DDR3 һ 1M ĳ¼, ֮/ƽֻ FPGA Ӽ¼
+// ³ 512 ֽڵͼ, ²ɼ. ͼ̶÷ֵʽ, κ´ڵë̶ᶪ.
+// ɼȡֵȡǰʱ N  1/128, ¼ԼΪ 16 Ԥʱ; Ŵ ( 1) ʱһֻ 2 ¼
+#define DEEP_RECORD_LEN   DEEP_LEN_MAX
+#define DEEP_STEP_MAX     (DEEP_RECORD_LEN / WAVEFORM_POINTS)   // ¼һ
+enum {
+    DEEP_OFF,
+    DEEP_CAPTURE,      // Ȳɼ
+    DEEP_VIEW,         // ͼ
+    DEEP_SHOWN         // ͼʾ, /ƽ
+};
+static uint8_t  deep_state = DEEP_OFF;
+static uint32_t deep_decim;     // ɼȡֵ
+static uint32_t deep_step;      // ͼ, һ {min, max}  2*step ¼
+static uint32_t deep_center;    // ͼ (¼)
+static uint32_t deep_ctrl_pend; // ͬ BUSY д DEEP_CTRL ֵ, 0 = û
+
+// ͬæʱд DEEP_CTRL (ɼ;˳洢ְ Deep, FPGA ڲһ),
+//  Deep_Poll  BUSY ٷ
+static void Deep_Ctrl_Write(uint32_t ctrl)
+{
+    uint32_t busy = (ctrl & DEEP_CTRL_CAPTURE_Msk) ? DEEP_STATUS_CAP_BUSY_Msk : DEEP_STATUS_VIEW_BUSY_Msk;
+
+    if (DEEP_STATUS_REG & busy) {
+        deep_ctrl_pend = ctrl;
+        return;
+    }
+    DEEP_CTRL_REG = ctrl;
+    deep_ctrl_pend = 0;
+}
+
+// ǰͼ, ļڼ¼Χ
+static void Deep_Request_View(void)
+{
+    uint32_t span = WAVEFORM_POINTS * deep_step;
+    uint32_t start = (deep_center > span / 2) ? deep_center - span / 2 : 0;
+
+    if (start > DEEP_RECORD_LEN - span) start = DEEP_RECORD_LEN - span;
+    deep_center = start + span / 2;
+    DEEP_VIEW_START_REG = start;
+    DEEP_VIEW_STEP_REG  = deep_step;
+    Deep_Ctrl_Write(DEEP_CTRL_VIEW_Msk | ((uint32_t)ANALOG_DECIM_PEAK << DEEP_CTRL_MODE_Pos));
+    deep_state = DEEP_VIEW;
+}
 
-void Handle_Analog_In_Page(void)
+static void Deep_Capture_Start(int time_div_index)
+{
+    uint32_t n = time_div_decim_cnt[time_div_index] >> 7;
+
+    deep_decim  = n ? n : 1;
+    deep_step   = DEEP_STEP_MAX;
+    deep_center = DEEP_RECORD_LEN / 2;
+    DEEP_LEN_REG   = DEEP_RECORD_LEN;
+    DEEP_DECIM_REG = deep_decim;
+    Deep_Ctrl_Write(DEEP_CTRL_CAPTURE_Msk);
+    deep_state = DEEP_CAPTURE;
+    Draw_Text_Boundary(Analog_Sample_Text, " Deep: capture");
+}
+
+// һ 10 , һ WAVEFORM_POINTS * step ¼
+static void Deep_Show_Info(void)
+{
+    uint32_t tdiv_ns = WAVEFORM_POINTS * deep_step * deep_decim * ADC_SAMPLE_NS / 10;
+    Update_Analog_Deep(tdiv_ns, DEEP_RECORD_LEN, (uint8_t)(deep_center * 100 / DEEP_RECORD_LEN));
+}
+
+static void Deep_Fail(char* why)
+{
+    deep_state = DEEP_OFF;
+    Draw_Text_Boundary(Analog_Sample_Text, why);
+    Draw_Normal_Button(Analog_Deep);
+}
+
+// ѭѯ DEEP_STATUS (ɼ, ռж); ͼ waveform_buffer 󷵻 1
+static int Deep_Poll(void)
+{
+    uint32_t st;
+
+    if (deep_ctrl_pend) {
+        Deep_Ctrl_Write(deep_ctrl_pend);
+        return 0;
+    }
+    st = DEEP_STATUS_REG;
+    if (deep_state == DEEP_CAPTURE) {
+        if (st & DEEP_STATUS_CAP_BUSY_Msk) return 0;
+        if (st & DEEP_STATUS_CAP_OK_Msk) Deep_Request_View();
+        else Deep_Fail((st & DEEP_STATUS_DDR_OK_Msk) ? " Deep: DDR busy" : " Deep: no DDR");
+        return 0;
+    }
+    if (deep_state == DEEP_VIEW) {
+        if (st & DEEP_STATUS_VIEW_BUSY_Msk) return 0;
+        if (!(st & DEEP_STATUS_VIEW_OK_Msk)) {
+            Deep_Fail(" Deep: lost");
+            return 0;
+        }
+        for (int i = 0; i < ANALOG_DATA_WORD_COUNT; i++)
+            waveform_buffer.u32[i] = DEEP_VIEW_WORDS[i];
+        waveform_offset = 0;
+        waveform_view_start = 0;
+        waveform_view_slots = WAVEFORM_POINTS / 2;
+        deep_state = DEEP_SHOWN;
+        Deep_Show_Info();
+        return 1;
+    }
+    return 0;
+}
+
+// Time+/Time-  2 , Ĳ
+static void Deep_Zoom(int zoom_in)
+{
+    if (zoom_in && deep_step > 1) deep_step >>= 1;
+    else if (!zoom_in && deep_step < DEEP_STEP_MAX) deep_step <<= 1;
+    else return;
+    Deep_Request_View();
+}
+
+// /֮һ: ƽư
+static void Deep_Pan(int x)
+{
+    uint32_t half = WAVEFORM_POINTS * deep_step / 2;
+    int third = Analog_WaveBoard.Width / 3;
+
+    if (x < Analog_WaveBoard.X1 + third)
+        deep_center = (deep_center > half) ? deep_center - half : 0;
+    else if (x >= Analog_WaveBoard.X1 + 2 * third)
+        deep_center += half;
+    else
+        return;
+    Deep_Request_View();
+}
+
+
+void Handle_Analog_In_Page(const Event_t* evt)
 {
     static uint8_t is_running = 0;
-    static uint8_t touch_processed = 0;
     static uint8_t buffer_is_valid = 0;
+    static uint8_t discard_frame = 0;   // ʱ仯һ֡ (ѷ֡ʱɼ)
+    static uint8_t decim_mode = ANALOG_DECIM_SAMPLE;  // ǰѡĳȡʽ
+    static uint8_t buffer_mode = ANALOG_DECIM_SAMPLE; // waveform_buffer ݵĳȡʽ ( ANALOG_ACQ_DUAL)
+    static uint8_t trig_index = 0;                      // Analog_Trig ť, ĬӲ
+    static uint8_t trig_level = ANALOG_TRIG_LEVEL_DEFAULT;
+    static Scope_Meas meas;                             // ֡: ƽȡһֵ֡
+    static uint8_t meas_due = 0;                        // Ĳ (5Hz) , һ֡ˢ²
+    static uint8_t meas_page = 0;                       // ʾ
 
     static int v_div_index = 3; // Ĭϵλ 1000mV (1.0V)/div
     static int time_div_index = 6; //  Ĭϵλ 1ms/div (cnt=500)
 
-    GT1151_Scan(&Touch_LCD, 1);
-    if (Touch_LCD.Touch_Num > 0 && !touch_processed)
+    if (evt->type == EVT_TOUCH)
     {
         uint8_t settings_changed = 0;
 
         if (Judge_TpXY(Touch_LCD, Analog_Exit.Box)) {
             is_running = 0;
             ANALOG_CONTROL_REG = 0;
+            deep_state = DEEP_OFF;
+            if (stats_view) {
+                stats_view = 0;
+                sprintf(Analog_Title.Text[0], "%s", "*** Analog in ***");
+                Analog_Title.Text[1][0] = '\0';
+            }
             currentPage = PAGE_MAIN;
             MODE_SELECT_REG = MODE_EXIT_TO_MAIN;
             Display_Main_board();
         }
+        else if (Judge_TpXY(Touch_LCD, Analog_Deep.Box)) {
+            // ٰһλصԤ (¼ DDR , ֱһβɼ̫ʹ DDR)
+            if (deep_state == DEEP_OFF) {
+                if (is_running) {
+                    is_running = 0;
+                    ANALOG_CONTROL_REG = 0;
+                    Draw_Normal_Button(Analog_Start);
+                    Draw_Button_Effect(Analog_Stop);
+                }
+                Draw_Button_Effect(Analog_Deep);
+                Deep_Capture_Start(time_div_index);
+            } else {
+                deep_state = DEEP_OFF;
+                Draw_Normal_Button(Analog_Deep);
+                Update_Analog_Display(v_div_options_mv[v_div_index], time_div_options_us[time_div_index]);
+            }
+        }
+        else if (deep_state == DEEP_SHOWN && Judge_TpXY(Touch_LCD, Analog_Freq_up.Box)) {
+            Deep_Zoom(1);
+        }
+        else if (deep_state == DEEP_SHOWN && Judge_TpXY(Touch_LCD, Analog_Freq_down.Box)) {
+            Deep_Zoom(0);
+        }
+        else if (deep_state == DEEP_SHOWN && Judge_TpXY(Touch_LCD, Analog_WaveBoard)) {
+            Deep_Pan(Touch_LCD.Tp_X[0]);
+        }
         else if (Judge_TpXY(Touch_LCD, Analog_Start.Box)) {
+            if (deep_state != DEEP_OFF) {
+                deep_state = DEEP_OFF;
+                Draw_Normal_Button(Analog_Deep);
+            }
             if (!is_running) {
                 is_running = 1;
 								//  ʱд뵱ǰʱֵ 
-                ANALOG_DECIM_REG = time_div_decim_cnt[time_div_index];
+                uint8_t acq_mode = Analog_Acq_Mode(decim_mode);
+                Analog_Roll_Setup(Analog_Write_Decim(time_div_index, acq_mode, trig_index), acq_mode, 1);
+                if (roll_active) buffer_mode = acq_mode;
+                Analog_Write_Trig(trig_index, trig_level);
+                // STOP ڼܲһ֡δ ACK ľ: READY Ѿ 1 Ͳж,
+                // ƹһҲһֱ ACK, ֱ ACK 
+                FPGA_IRQ_Take(FPGA_IRQ_ANALOG_READY_Msk);
+                if (ANALOG_STATUS_REG & ANALOG_STATUS_DATA_READY_Msk) {
+                    ANALOG_CONTROL_REG = (1U << ANALOG_CTRL_ACK_DATA_Pos);
+                }
                 ANALOG_CONTROL_REG = (1U << ANALOG_CTRL_START_STOP_Pos);
+                discard_frame = 0;
                 Draw_Button_Effect(Analog_Start);
                 Draw_Normal_Button(Analog_Stop);
             }
@@ -258,104 +889,170 @@ void Handle_Analog_In_Page(void)
             if (time_div_index < time_div_max_index) time_div_index++; // T/Div  ()
             settings_changed = 1;
         }
+        else if (Judge_TpXY(Touch_LCD, Analog_Mode.Box)) {
+            decim_mode = (decim_mode + 1) % ANALOG_MODE_LEVELS;
+            sprintf(Analog_Mode.Text[0], "%s", ANALOG_MODE_NAMES[decim_mode]);
+            Draw_Normal_Button(Analog_Mode);
+            settings_changed = 1;
+        }
+        else if (Judge_TpXY(Touch_LCD, Analog_Trig.Box)) {
+            trig_index = (trig_index + 1) % ANALOG_TRIG_LEVELS;
+            sprintf(Analog_Trig.Text[0], "%s", ANALOG_TRIG_NAMES[trig_index]);
+            Draw_Normal_Button(Analog_Trig);
+            settings_changed = 1;
+        }
+        else if (Judge_TpXY(Touch_LCD, Analog_FFT.Box)) {
+            // һֻлʾ, ɼò, ض֡; ʱͬʱл/֡ɼ
+            spectrum_view = !spectrum_view;
+            sprintf(Analog_FFT.Text[0], "%s", spectrum_view ? "FFT" : "YT");
+            Draw_Normal_Button(Analog_FFT);
+            if (Analog_Is_Roll(time_div_index) != roll_active)
+                settings_changed = 1;
+            else if (buffer_is_valid)
+                Analog_Draw_Buffer(buffer_mode, v_div_options_mv[v_div_index]);
+        }
+        else if (Judge_TpXY(Touch_LCD, Analog_Title.Box)) {
+            Analog_Stats_Show(!stats_view);
+        }
+        else if (Judge_TpXY(Touch_LCD, Analog_CH.Box)) {
+            // ˫ͨڼȡʽťѡ, صͨʱЧ
+            dual_view = !dual_view;
+            sprintf(Analog_CH.Text[0], "%s", dual_view ? "2CH" : "1CH");
+            Draw_Normal_Button(Analog_CH);
+            settings_changed = 1;
+        }
         else if (Judge_TpXY(Touch_LCD, Analog_Reset.Box)) {
             v_div_index = 3;
             time_div_index = 6; // ָĬ 1ms/div
+            decim_mode = ANALOG_DECIM_SAMPLE;
+            sprintf(Analog_Mode.Text[0], "%s", ANALOG_MODE_NAMES[decim_mode]);
+            Draw_Normal_Button(Analog_Mode);
+            dual_view = 0;
+            sprintf(Analog_CH.Text[0], "%s", "1CH");
+            Draw_Normal_Button(Analog_CH);
+            trig_index = 0;
+            trig_level = ANALOG_TRIG_LEVEL_DEFAULT;
+            sprintf(Analog_Trig.Text[0], "%s", ANALOG_TRIG_NAMES[trig_index]);
+            Draw_Normal_Button(Analog_Trig);
+            settings_changed = 1;
+        }
+        else if (Judge_TpXY(Touch_LCD, Analog_WaveBoard)) {
+            // : ƽΪôӦĵѹ
+            trig_level = Scope_Code_At_Y(Analog_WaveBoard, v_div_options_mv[v_div_index], Touch_LCD.Tp_Y[0]);
             settings_changed = 1;
         }
 
         if (settings_changed) {
 						//  ֻҪñ仯дµʱֵ 
-            ANALOG_DECIM_REG = time_div_decim_cnt[time_div_index];
+            uint8_t acq_mode = Analog_Acq_Mode(decim_mode);
+            uint32_t decim = Analog_Write_Decim(time_div_index, acq_mode, trig_index);
+            Analog_Write_Trig(trig_index, trig_level);
+            // FPGA ⵽ʱ/ȡʽ/仯ᶪдİ֡, ֻٶѷһ֡
+            discard_frame = 1;
+            // ֹͣʱĻ (ҪͣĲ), ʱٰǰýʽ
+            if (is_running) {
+                Analog_Roll_Setup(decim, acq_mode, 0);
+                if (roll_active) buffer_mode = acq_mode;
+            }
 					
             Update_Analog_Display(v_div_options_mv[v_div_index], time_div_options_us[time_div_index]);
+            if (deep_state == DEEP_SHOWN) Deep_Show_Info();
 
             if (buffer_is_valid) {
-                Draw_Scope_Grid(Analog_WaveBoard);
-                Draw_Scope_Waveform(waveform_buffer, WAVEFORM_POINTS, Analog_WaveBoard, v_div_options_mv[v_div_index]);
+                // 浵λ仯, ֻ谴µλػ (ԭĳȡʽ)
+                Analog_Draw_Buffer(buffer_mode, v_div_options_mv[v_div_index]);
             }
         }
-
-        touch_processed = 1;
     }
-    else if (Touch_LCD.Touch_Num == 0) {
-        touch_processed = 0;
+
+    // ͳƵӡ洢״̬дָ붼ѯ, ֻڽ¼ (ѯ, 100Hz) ;
+    // ֡ݿ FPGA жϱ־, κ¼϶ȡ (EVT_FPGA ʱһ¼)
+    if (evt->type == EVT_MEAS)
+        meas_due = 1;
+    if (evt->type == EVT_TICK && is_running && stats_view)
+        Analog_Stats_Update();
+
+    if (deep_state != DEEP_OFF) {
+        if (evt->type == EVT_TICK && Deep_Poll()) {
+            buffer_mode = ANALOG_DECIM_PEAK;
+            Analog_Draw_Buffer(buffer_mode, v_div_options_mv[v_div_index]);
+            buffer_is_valid = 1;
+        }
+        return;
     }
 
 		// ===================================================================
-    //  ޸ģԶѯ 
+    // ȴ READY ж: FPGA Ϊƹ˫, ɼ M1 /ˢֹͣ
     // ===================================================================
-    if (is_running)
+    if (is_running && roll_active)
+    {
+        // ʽû֡. ǰһ֡û ACK ֱ ACK, ص֡ʽȲ֡
+        if (FPGA_IRQ_Take(FPGA_IRQ_ANALOG_READY_Msk))
+            Analog_Ack_Frame();
+        // µ벢ػ (ֻı仯); һˢ²
+        if (evt->type == EVT_TICK && Analog_Roll_Read(buffer_mode) > 0) {
+            if (meas_due && roll_meas_slots >= waveform_view_slots) {
+                meas_due = 0;
+                roll_meas_slots = 0;
+                Analog_Roll_Measure(buffer_mode, &meas);
+                Analog_Show_Measure(&meas, v_div_index, time_div_index, buffer_mode, trig_index, &meas_page);
+            }
+            Analog_Draw_Buffer(buffer_mode, v_div_options_mv[v_div_index]);
+            buffer_is_valid = 1;
+        }
+    }
+    else if (is_running)
     {
-        // ѯȴFPGAݾ
-        if (ANALOG_STATUS_REG & ANALOG_STATUS_DATA_READY_Msk)
+        // EXTINT_0_Handler  READY λ־
+        if (FPGA_IRQ_Take(FPGA_IRQ_ANALOG_READY_Msk))
         {
-            // 1)  512 㣨0..511
-            for (int i = 0; i < WAVEFORM_POINTS; i++) {
-                waveform_buffer[i] = ANALOG_DATA_BUFFER[i];
+            // 1) ֶ 512 ֽ, 뵽Ļм; Ҫ֡, ֻ ACK
+            uint8_t triggered = 1;
+            if (!discard_frame) {
+                uint8_t acq_mode = Analog_Acq_Mode(decim_mode);
+                Analog_Read_Frame(acq_mode, &meas);
+                buffer_mode = acq_mode;
+                waveform_view_start = 0;
+                waveform_view_slots = (acq_mode == ANALOG_DECIM_SAMPLE) ? WAVEFORM_POINTS : WAVEFORM_POINTS / 2;
+                if (ANALOG_TRIG_SRC(trig_index) == ANALOG_TRIG_SRC_SW) {
+                    triggered = Analog_Soft_Trigger(acq_mode, trig_index, trig_level);
+                }
             }
 
-            // 2)  򻯰֣START|ACK  START 
-            //    Ȼִ֣Ϊڡһ֡Чģ
-            //     READY źš
-            #if defined(__arm__) || defined(__ARM_ARCH)
-            uint32_t __primask = __get_PRIMASK();
-            __disable_irq();               // ٽȷд벻ᱻжϴ
-            #endif
-
-            // һдSTART|ACK
-            ANALOG_CONTROL_REG =
-                (1U << ANALOG_CTRL_START_STOP_Pos) |
-                (1U << ANALOG_CTRL_ACK_DATA_Pos);
-            
-            // ܹϣѡ
-            #if defined(__arm__) || defined(__ARM_ARCH)
-            __DSB(); __ISB();
-            #endif
+            // 2) ֣START|ACK  START
+            Analog_Ack_Frame();
 
-            // ڶд STARTACK  0
-            ANALOG_CONTROL_REG = (1U << ANALOG_CTRL_START_STOP_Pos);
-
-            #if defined(__arm__) || defined(__ARM_ARCH)
-            if (!__primask) __enable_irq();
-            #endif
 
+            // 3) ٵ READY  0: һ֡µж֪ͨ
+            if (discard_frame) {
+                discard_frame = 0;
+                return;
+            }
+            // ڲˢ (۱֡Ƿ񴥷, Ķ֡)
+            if (meas_due) {
+                meas_due = 0;
+                Analog_Show_Measure(&meas, v_div_index, time_div_index, buffer_mode, trig_index, &meas_page);
+            }
 
-            // 3)  READY Ӳ 0ȷ FPGA Ե ACK
-            {
-                uint32_t spin = 0;
-                const uint32_t SPIN_MAX = 200000;   
-                while ((ANALOG_STATUS_REG & ANALOG_STATUS_DATA_READY_Msk) && (spin++ < SPIN_MAX)) {
-                    // ȴ READY źűϣǣACK
-                }
+            // ûҵ: Ļһ֡Ĳ (ƵײҪ, ճˢ)
+            if (!triggered && !spectrum_view) {
+                buffer_is_valid = 0;
+                return;
             }
-            
+
             // 4) ˢʾ (ACK֮)
-            Draw_Scope_Grid(Analog_WaveBoard);
-            Draw_Scope_Waveform(
-                waveform_buffer,
-                WAVEFORM_POINTS,
-                Analog_WaveBoard,
-                v_div_options_mv[v_div_index]
-            );
+            //    ÿ֡ػ, Draw_Scope_Waveform ֻһ֡θǵ
+            #ifdef LCD_BUS_STAT
+            lcd_bus_stat_reset();
+            #endif
+            Analog_Draw_Buffer(buffer_mode, v_div_options_mv[v_div_index]);
             buffer_is_valid = 1;
-
-
-            // ================================================================
-            //  Զ 
-            // ACKǷɹλFPGAwptr,
-            // Ƕǿģһ STOP -> START ڡ
-            // ⽫÷ֵġSTART/STOPˢ¡ȷһ֡
-            // ================================================================
-
-            // 1: ģⰴ "STOP"
-            ANALOG_CONTROL_REG = 0;
-
-            // 2: ģⰴ "START"
-            // (´FPGAʼɼis_running ־λȻΪ1,
-            // һѯȴ²ɼ֡)
-						ANALOG_DECIM_REG = time_div_decim_cnt[time_div_index];
-            ANALOG_CONTROL_REG = (1U << ANALOG_CTRL_START_STOP_Pos);
+            #ifdef LCD_BUS_STAT
+            // ÿ֡LCDд (/)
+            printf("scope frame: cmd=%lu data=%lu\r\n",
+                   (unsigned long)lcd_bus_stat.cmd_writes,
+                   (unsigned long)lcd_bus_stat.data_writes);
+            #endif
         }
     }
 }
@@ -363,10 +1060,8 @@ void Handle_Analog_In_Page(void)
 
 
 // --- ҳ洦  ---
-void Handle_Digital_In_Page(void)
+void Handle_Digital_In_Page(const Event_t* evt)
 {
-	
-    static uint8_t touch_processed = 0;
     static uint8_t is_measuring = 0;
     static DigitalMode_t current_mode = DIGITAL_MODE_MEASURE;
 	
@@ -375,10 +1070,8 @@ void Handle_Digital_In_Page(void)
 	
     static EncodingType_t current_encoding = ENCODE_NRZ_L; 
 
-    GT1151_Scan(&Touch_LCD, 1);
-    
     // --- 1. ߼ ---
-    if (Touch_LCD.Touch_Num > 0 && !touch_processed)
+    if (evt->type == EVT_TOUCH)
     {
         // --- 1.1 ˳ģʽл (޸) ---
         if (Judge_TpXY(Touch_LCD, Digital_Exit.Box)) {
@@ -391,7 +1084,6 @@ void Handle_Digital_In_Page(void)
             currentPage = PAGE_MAIN;
             MODE_SELECT_REG = MODE_EXIT_TO_MAIN;
             Display_Main_board();
-            touch_processed = 1; 
             return;
         }
         else if (Judge_TpXY(Touch_LCD, Digital_Mode_Measure.Box)) {
@@ -417,6 +1109,11 @@ void Handle_Digital_In_Page(void)
                 if (Judge_TpXY(Touch_LCD, Digital_Start.Box)) {
                     if (!is_measuring) {
                         is_measuring = 1;
+                        //  READY ٲж,  ACK 
+                        FPGA_IRQ_Take(FPGA_IRQ_DIGITAL_MEAS_Msk);
+                        if (DIGITAL_STATUS_REG & DIGITAL_STATUS_READY_Msk) {
+                            DIGITAL_CONTROL_REG = (1U << DIGITAL_CTRL_ACK_Pos);
+                        }
                         DIGITAL_CONTROL_REG = (1U << DIGITAL_CTRL_START_STOP_Pos);
                         Draw_Button_Effect(Digital_Start);
                         Draw_Normal_Button(Digital_Pause);
@@ -469,6 +1166,7 @@ void Handle_Digital_In_Page(void)
                         is_measuring = 1;
                         DIGITAL_CAPTURE_CONTROL_REG = (1U << CAPTURE_CTRL_ACK_Pos);
                         DIGITAL_CAPTURE_CONTROL_REG = 0;
+                        FPGA_IRQ_Take(FPGA_IRQ_CAPTURE_READY_Msk);
                         DIGITAL_CAPTURE_CONTROL_REG = (1U << CAPTURE_CTRL_START_STOP_Pos);
                         
                         Draw_Button_Effect(Digital_Start);
@@ -488,18 +1186,13 @@ void Handle_Digital_In_Page(void)
                 }
             }
         }
-        touch_processed = 1; 
-    }
-    // --- 1.3 ͷ (޸) ---
-    else if(Touch_LCD.Touch_Num == 0) {
-        touch_processed = 0;
     }
 
-    // --- 2. ѯ߼ (Polling Logic) (޸) ---
+    // --- 2. ݾ ( EXTINT_0_Handler λжϱ־) ---
     if (is_measuring) {
         if (current_mode == DIGITAL_MODE_MEASURE) {
             // ... (ģʽѯ) ...
-            if (DIGITAL_STATUS_REG & DIGITAL_STATUS_READY_Msk)
+            if (FPGA_IRQ_Take(FPGA_IRQ_DIGITAL_MEAS_Msk))
             {
                 uint32_t period_raw = DIGITAL_PERIOD_REG;
                 uint32_t high_time_raw = DIGITAL_HIGH_TIME_REG;
@@ -522,8 +1215,8 @@ void Handle_Digital_In_Page(void)
                 Update_Digital_Display(frequency_hz, duty_percent, high_time_ns, low_time_ns);
             }
         } else { 
-			// --- ģʽѯ (޸) ---
-            if (DIGITAL_CAPTURE_STATUS_REG & CAPTURE_STATUS_READY_Msk) {
+			// --- ģʽĲɴ ---
+            if (FPGA_IRQ_Take(FPGA_IRQ_CAPTURE_READY_Msk)) {
                 
                 volatile uint32_t* bram_ptr = (volatile uint32_t*)DIGITAL_CAPTURE_BUFFER;
 
@@ -538,7 +1231,9 @@ void Handle_Digital_In_Page(void)
                 DIGITAL_CAPTURE_CONTROL_REG = (1U << CAPTURE_CTRL_ACK_Pos);
                 DIGITAL_CAPTURE_CONTROL_REG = 0; 
                 
+                PROF_START(PROF_DIGITAL_ANALYZE);
                 Analyze_and_Display_Signal(capture_buffer, CAPTURE_POINTS, current_freq_code, current_baud_code, current_encoding);
+                PROF_STOP(PROF_DIGITAL_ANALYZE);
 
                 is_measuring = 0; 
                 Draw_Normal_Button(Digital_Start);
@@ -549,13 +1244,20 @@ void Handle_Digital_In_Page(void)
 }
 
 // --- USB_CDCҳ洦  ---
-void Handle_USB_CDC_Page(void)
+void Handle_USB_CDC_Page(const Event_t* evt)
 {
     static uint8_t is_running = 0; // 0=Stop, 1=Start
-    static uint8_t touch_processed = 0;
 
-    GT1151_Scan(&Touch_LCD, 1);
-    if (Touch_LCD.Touch_Num > 0 && !touch_processed)
+    // ػڼ䲻Ӧ, ʱҳ
+    if (usb_cdc_loading) {
+        if (Time_Expired_ms(usb_cdc_ready_at)) {
+            usb_cdc_loading = 0;
+            Display_USB_CDC();
+        }
+        return;
+    }
+
+    if (evt->type == EVT_TOUCH)
     {
         // 1. ˳ť
         if (Judge_TpXY(Touch_LCD, USB_CDC_Exit.Box)) {
@@ -589,11 +1291,6 @@ void Handle_USB_CDC_Page(void)
                 Draw_Button_Effect(USB_CDC_Stop);
             }
         }
-        
-        touch_processed = 1;
-    }
-    else if(Touch_LCD.Touch_Num == 0) {
-        touch_processed = 0;
     }
 
     // (ע⣺ҳûѯ߼ΪM1ݴ)
@@ -2,6 +2,7 @@
 #define __EVENT_HANDLER_H__
 
 #include "main.h"
+#include "event_queue.h"
 
 // ============================================================================
 //  ļ¼˿ģ鹲á
@@ -10,13 +11,16 @@
 // --- 1. ö ---
 #define WAVEFORM_POINTS 512
 #define ADC_FSR_MV 3300 // ADC̵ѹλ: (mV)
+#define ADC_SAMPLE_NS 40 // ADC (25MHz)ȡֵ N ӦĵΪ N*40ns
 
 // --- 2. ¼ ---
-void Handle_Main_Page(void);
-void Handle_Wave_Out_Page(void);
-void Handle_Analog_In_Page(void);
-void Handle_Digital_In_Page(void);
-void Handle_USB_CDC_Page(void);
+// ѭ¼ȡ¼󽻸ǰҳ: EVT_TOUCH Ϊһΰ (ѷŽ Touch_LCD),
+// EVT_TICK/EVT_FPGA ѯݴ. ҳлڴ, һ¼ҳ
+void Handle_Main_Page(const Event_t* evt);
+void Handle_Wave_Out_Page(const Event_t* evt);
+void Handle_Analog_In_Page(const Event_t* evt);
+void Handle_Digital_In_Page(const Event_t* evt);
+void Handle_USB_CDC_Page(const Event_t* evt);
 
 // --- 3. λ (ʹλ: ) ---
 extern const uint16_t v_div_options_mv[];
@@ -24,6 +28,13 @@ extern const uint32_t time_div_options_us[];
 #define V_DIV_LEVELS (sizeof(v_div_options_mv)/sizeof(uint16_t))
 #define TIME_DIV_LEVELS (sizeof(time_div_options_us)/sizeof(uint16_t))
 
+// --- 4. FPGA ݾж ---
+// EXTINT_0_Handler  FPGA_IRQ_STATUS_REG Ĺλۻ g_fpga_irq_flags,
+// ҳ洦 FPGA_IRQ_Take() ȡ߲ĵλ, ѯ״̬Ĵ
+extern volatile uint32_t g_fpga_irq_flags;
+void FPGA_IRQ_Init(void);
+uint32_t FPGA_IRQ_Take(uint32_t mask);
+
 //  빦ܵģʽ
 typedef enum {
     DIGITAL_MODE_MEASURE, // ģʽ
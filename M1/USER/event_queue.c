@@ -0,0 +1,99 @@
+#include <string.h>
+#include "event_queue.h"
+#include "GOWIN_M1.h"
+#include "fpga_registers.h"
+#include "systime.h"
+
+// head/tail ɵ, õλȡģ; ֵе¼
+static Event_t event_ring[EVENT_QUEUE_SIZE];
+static volatile uint8_t event_head = 0;    // ֻ (Event_Post) д
+static volatile uint8_t event_tail = 0;    // ֻ (Event_Get) д
+// Event_Post_Once Ͷݡûȡߵ¼ (λ). ˢʱġ INT Ѷռ,
+// ѭ Time_ms() õʵʱ,  GT1151 µ
+static volatile uint32_t event_pending = 0;
+
+Event_Stats_t event_stats;
+
+void Event_Queue_Init(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    event_head = 0;
+    event_tail = 0;
+    event_pending = 0;
+    memset(&event_stats, 0, sizeof(event_stats));
+    if (!primask) __enable_irq();
+}
+
+uint8_t Event_Post(uint8_t type, uint32_t arg)
+{
+    uint8_t ok = 0;
+    uint8_t depth;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    depth = (uint8_t)(event_head - event_tail);
+    if (depth < EVENT_QUEUE_SIZE) {
+        Event_t* e = &event_ring[event_head & (EVENT_QUEUE_SIZE - 1)];
+        e->type  = type;
+        e->arg   = arg;
+        e->stamp = FPGA_STAT_TICKS_REG;
+        // дλƶ head, ߿ head ʱѾ
+        event_head = event_head + 1;
+        event_stats.posted++;
+        if (depth + 1 > event_stats.depth_max) event_stats.depth_max = depth + 1;
+        ok = 1;
+    } else {
+        event_stats.dropped++;
+    }
+    if (!primask) __enable_irq();
+    return ok;
+}
+
+uint8_t Event_Post_Once(uint8_t type, uint32_t arg)
+{
+    uint8_t ok = 0;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!(event_pending & (1U << type)) && Event_Post(type, arg)) {
+        event_pending |= 1U << type;
+        ok = 1;
+    }
+    if (!primask) __enable_irq();
+    return ok;
+}
+
+uint8_t Event_Get(Event_t* evt)
+{
+    uint8_t tail = event_tail;
+
+    if (tail == event_head) return 0;
+    *evt = event_ring[tail & (EVENT_QUEUE_SIZE - 1)];
+    // ȶλƶ tail, ߲֮ſܸλ
+    event_tail = tail + 1;
+    if (event_pending & (1U << evt->type)) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        event_pending &= ~(1U << evt->type);
+        if (!primask) __enable_irq();
+    }
+    return 1;
+}
+
+uint8_t Event_Queue_Empty(void)
+{
+    return event_tail == event_head;
+}
+
+void Event_Done(const Event_t* evt)
+{
+    uint32_t lat = FPGA_STAT_TICKS_REG - evt->stamp;
+
+    if (evt->type >= EVT_TYPE_COUNT) return;
+    event_stats.lat_last[evt->type] = lat;
+    if (lat > event_stats.lat_max[evt->type]) event_stats.lat_max[evt->type] = lat;
+}
+
+void Event_Tick_ISR(void)
+{
+    Event_Post_Once(EVT_TICK, Time_ms());
+}
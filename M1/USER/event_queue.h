@@ -0,0 +1,65 @@
+#ifndef __EVENT_QUEUE_H__
+#define __EVENT_QUEUE_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  жҳ洦֮¼.
+//  ж (SysTick, FPGA ݾ, GT1151  INT) Ͷݴ͵¼, ѭȡ
+//  ַǰҳ; пʱѭ WFI, ֱһж.
+//
+//  /߻λ:
+//    - ֻд head. ж (ԼѭԼ) Ͷ, Event_Post ڲ PRIMASK,
+//      ߱гһ, Ҫ;
+//    - ֻѭ, ֻд tail, Event_Get ж (ֻ Event_Post_Once ĺϲ־ʱһ).
+//  ʱ¼. FPGA жϵĹλۻ g_fpga_irq_flags ,
+//  һ EVT_FPGA ᶪ, һ¼ʱҳȡ.
+//
+//  ÿ¼Ͷʱ (FPGA_STAT_TICKS_REG, HCLK ), ҳ洦 (Ѹ) 
+//  Event_Done ¼ "¼ -> Ļ" ӳ, ¼ͳһκֵ.
+// ============================================================================
+
+typedef enum {
+    EVT_NONE = 0,
+    EVT_TICK,          // SysTick , arg = ͶʱĽļ (ϲͶ, ѹʱ,  Time_ms()).
+                       // ѭе,
+                       // ҳյ EVT_TICK ǵѯ (100Hz) ת
+    EVT_TOUCH,         // , arg = EVT_TOUCH_ARG(x, y)
+    EVT_TOUCH_INT,     // GT1151 INT ½: µĴ, ɴ (ҳ治)
+    EVT_MEAS,          // ˢ (5Hz), ɵֱӷҳ, 
+    EVT_FPGA,          // FPGA ݾж, arg = ж϶Ĺλ
+    EVT_TYPE_COUNT
+} EventType_t;
+
+typedef struct {
+    uint8_t  type;     // EventType_t
+    uint32_t arg;
+    uint32_t stamp;    // Ͷʱ FPGA_STAT_TICKS_REG
+} Event_t;
+
+#define EVENT_QUEUE_SIZE  16   //  2 
+
+#define EVT_TOUCH_ARG(x, y) (((uint32_t)(x) << 16) | ((uint32_t)(y) & 0xFFFF))
+#define EVT_TOUCH_X(arg)    ((uint16_t)((arg) >> 16))
+#define EVT_TOUCH_Y(arg)    ((uint16_t)(arg))
+
+typedef struct {
+    uint32_t posted;                       // ɹͶݵ¼
+    uint32_t dropped;                      // ¼
+    uint8_t  depth_max;                    // ʱ¼
+    uint32_t lat_last[EVT_TYPE_COUNT];     // ¼ -> ɵӳ, λ HCLK 
+    uint32_t lat_max[EVT_TYPE_COUNT];
+} Event_Stats_t;
+
+extern Event_Stats_t event_stats;
+
+void Event_Queue_Init(void);
+uint8_t Event_Post(uint8_t type, uint32_t arg);   // жϻѭ,  0
+// ͬ¼ڶʱͶ (ġ INT  "" ֪ͨ),  0
+uint8_t Event_Post_Once(uint8_t type, uint32_t arg);
+uint8_t Event_Get(Event_t* evt);                  // ֻѭ, û¼ 0
+uint8_t Event_Queue_Empty(void);
+void Event_Done(const Event_t* evt);              // ҳ洦һ¼, ¼ӳ
+void Event_Tick_ISR(void);                        //  SysTick_Handler 
+
+#endif // __EVENT_QUEUE_H__
@@ -0,0 +1,187 @@
+#include "i2c_async.h"
+#include "GOWIN_M1.h"
+#include "systime.h"
+
+// OpenCores I2C жλ (SDK ͷļûжʱ)
+#ifndef I2C_CTR_IEN
+#define I2C_CTR_IEN   (1U << 6)
+#endif
+#ifndef I2C_CMD_IACK
+#define I2C_CMD_IACK  (1U << 0)
+#endif
+#ifndef I2C_SR_AL
+#define I2C_SR_AL     (1U << 5)
+#endif
+
+enum {
+    STEP_ADDR_W,       // ѷ START+SLA+W
+    STEP_REG_H,        // ѷĴ 8 λ
+    STEP_REG_L,        // ѷĴ 8 λ
+    STEP_ADDR_R,       // ѷ START+SLA+R
+    STEP_WRITE,        // ѷһֽ
+    STEP_READ,         // Ѷһֽ
+    STEP_STOP          //  STOP, ɺ󱨸
+};
+
+static I2C_Xfer_t* volatile i2c_head = 0;   // Ϊǰ (ȴ) 
+static I2C_Xfer_t* i2c_tail = 0;
+static uint8_t  i2c_active = 0;             // Ѿʼ
+static uint8_t  i2c_error;                  // STEP_STOP ɺҪ״̬
+static uint32_t i2c_ready_at = 0;           // д֮ļʱ (ms)
+
+void I2C_Async_Init(void)
+{
+    I2C->CTR |= I2C_CTR_IEN;
+    NVIC_EnableIRQ(I2C_IRQn);
+}
+
+void I2C_Xfer_Setup(I2C_Xfer_t* x, uint8_t dev_addr, uint16_t reg, uint8_t* buf, uint16_t len,
+                    uint8_t read, void (*done)(I2C_Xfer_t* x))
+{
+    x->dev_addr = dev_addr;
+    x->reg      = reg;
+    x->buf      = buf;
+    x->len      = len;
+    x->read     = read;
+    x->done     = done;
+    x->status   = I2C_XFER_IDLE;
+}
+
+// ׻ûʼдѹ߿ʱһֽ. ʱѹжϻж
+static void I2C_Start_Head(void)
+{
+    I2C_Xfer_t* x = i2c_head;
+
+    if (x == 0 || i2c_active) return;
+    if (!Time_Expired_ms(i2c_ready_at)) return;
+    if (I2C->SR & I2C_SR_BUSY) return;      // һʵ STOP û, һ
+
+    i2c_active = 1;
+    x->status = I2C_XFER_BUSY;
+    x->step   = STEP_ADDR_W;
+    x->pos    = 0;
+    I2C->TXR  = x->dev_addr;
+    I2C->CR   = I2C_CMD_STA | I2C_CMD_WR;
+}
+
+uint8_t I2C_Submit(I2C_Xfer_t* x)
+{
+    uint32_t primask;
+
+    if (x->status == I2C_XFER_QUEUED || x->status == I2C_XFER_BUSY) return 0;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    x->status = I2C_XFER_QUEUED;
+    x->next = 0;
+    if (i2c_head == 0) i2c_head = x;
+    else i2c_tail->next = x;
+    i2c_tail = x;
+    I2C_Start_Head();
+    if (!primask) __enable_irq();
+    return 1;
+}
+
+uint8_t I2C_Xfer_Run(I2C_Xfer_t* x)
+{
+    I2C_Submit(x);
+    while (x->status == I2C_XFER_QUEUED || x->status == I2C_XFER_BUSY)
+        __WFI();
+    return x->status;
+}
+
+// : ӡص, һ
+static void I2C_Finish(uint8_t status)
+{
+    I2C_Xfer_t* x = i2c_head;
+
+    i2c_head = x->next;
+    if (i2c_head == 0) i2c_tail = 0;
+    i2c_active = 0;
+    if (!x->read) i2c_ready_at = Time_Deadline_ms(I2C_WRITE_HOLDOFF_MS + 1);   // һĵĲֲ
+
+    x->status = status;
+    if (x->done) x->done(x);
+    I2C_Start_Head();
+}
+
+// :  STOP ͷ, STOP ɺٱ
+static void I2C_Abort(uint8_t status)
+{
+    i2c_head->step = STEP_STOP;
+    i2c_error = status;
+    I2C->CR = I2C_CMD_STO;
+}
+
+// /дݽ׶ηһֽ, һֽڴ STOP (Ϊ NACK+STOP)
+static void I2C_Next_Data(I2C_Xfer_t* x)
+{
+    uint8_t last = (x->pos == x->len - 1);
+
+    if (x->read) {
+        x->step = STEP_READ;
+        I2C->CR = last ? (I2C_CMD_ACK | I2C_CMD_STO | I2C_CMD_RD) : I2C_CMD_RD;
+    } else {
+        x->step = STEP_WRITE;
+        I2C->TXR = x->buf[x->pos];
+        I2C->CR = last ? (I2C_CMD_STO | I2C_CMD_WR) : I2C_CMD_WR;
+    }
+}
+
+void I2C_Async_IRQ(void)
+{
+    I2C_Xfer_t* x = i2c_head;
+    uint32_t sr = I2C->SR;
+
+    I2C->CR = I2C_CMD_IACK;
+    if (x == 0 || !i2c_active) return;
+
+    if (sr & I2C_SR_AL) {               // ٲöʧʱѷ, ٷ STOP
+        I2C_Finish(I2C_XFER_LOST);
+        return;
+    }
+    if (x->step == STEP_STOP) {
+        I2C_Finish(i2c_error);
+        return;
+    }
+    if (x->step != STEP_READ && (sr & I2C_SR_RXACK)) {
+        I2C_Abort(I2C_XFER_NACK);
+        return;
+    }
+
+    switch (x->step) {
+    case STEP_ADDR_W:
+        x->step = STEP_REG_H;
+        I2C->TXR = x->reg >> 8;
+        I2C->CR = I2C_CMD_WR;
+        break;
+    case STEP_REG_H:
+        x->step = STEP_REG_L;
+        I2C->TXR = x->reg & 0xFF;
+        I2C->CR = I2C_CMD_WR;
+        break;
+    case STEP_REG_L:
+        if (x->read) {
+            x->step = STEP_ADDR_R;
+            I2C->TXR = x->dev_addr | 0x01;
+            I2C->CR = I2C_CMD_STA | I2C_CMD_WR;
+        } else {
+            I2C_Next_Data(x);
+        }
+        break;
+    case STEP_ADDR_R:
+        I2C_Next_Data(x);
+        break;
+    case STEP_WRITE:
+    case STEP_READ:
+        if (x->read) x->buf[x->pos] = I2C->RXR;
+        if (++x->pos < x->len) I2C_Next_Data(x);
+        else I2C_Finish(I2C_XFER_OK);
+        break;
+    }
+}
+
+void I2C_Async_Tick(void)
+{
+    if (i2c_head != 0 && !i2c_active) I2C_Start_Head();
+}
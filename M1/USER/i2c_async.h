@@ -0,0 +1,56 @@
+#ifndef __I2C_ASYNC_H__
+#define __I2C_ASYNC_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  ж I2C  ( GT1151 ).
+//  ׼һ (ַ16 λĴַȡ/дɻص)
+//   I2C_Submit ŶӺ; ÿֽڴ I2C  IF  I2C_Handler,
+//   I2C_Async_IRQ ƽһ, ڼ CPU ٵ TIP/RXACK/BUSY.
+//
+//  һδĲ (ԭȵдͬ):
+//    д: START+SLA+W, Ĵ 8 λ,  8 λ,  ... (һֽڴ STOP)
+//    : START+SLA+W, Ĵ 8 λ,  8 λ, START+SLA+R,  ... (һֽ NACK+STOP)
+//  д֮ I2C_WRITE_HOLDOFF_MS ٿʼһ (GT1151 д),  SysTick 
+//  I2C_Async_Tick , ԭд 3ms æ.
+//
+//  صжִ, ֻӦٵ (ݡͶ¼ύһʴ).
+//  ֮ǰ, ޸Ļظύ.
+// ============================================================================
+
+#define I2C_WRITE_HOLDOFF_MS 3
+
+enum {
+    I2C_XFER_IDLE = 0,     // δύȡ߽
+    I2C_XFER_QUEUED,       // Ŷ
+    I2C_XFER_BUSY,         // ڴ
+    I2C_XFER_OK,
+    I2C_XFER_NACK,         // ûӦ
+    I2C_XFER_LOST          // ٲöʧ
+};
+
+typedef struct I2C_Xfer I2C_Xfer_t;
+struct I2C_Xfer {
+    uint8_t  dev_addr;                 // 8 λַ (дַ)
+    uint16_t reg;                      // 16 λĴַ
+    uint8_t* buf;
+    uint16_t len;                      //  1
+    uint8_t  read;                     // 1=, 0=д
+    void (*done)(I2C_Xfer_t* x);       // ɻص (же), Ϊ 0
+    volatile uint8_t status;           // I2C_XFER_xxx
+    // ʹ
+    uint8_t  step;
+    uint16_t pos;
+    I2C_Xfer_t* next;
+};
+
+void I2C_Async_Init(void);             //  I2C_Init ֮,  I2C ж
+void I2C_Xfer_Setup(I2C_Xfer_t* x, uint8_t dev_addr, uint16_t reg, uint8_t* buf, uint16_t len,
+                    uint8_t read, void (*done)(I2C_Xfer_t* x));
+uint8_t I2C_Submit(I2C_Xfer_t* x);     // Ŷ, ûʱ 0
+uint8_t I2C_Xfer_Run(I2C_Xfer_t* x);   // ύ˯ߵȴ (ֻڳʼ), ״̬
+void I2C_Async_IRQ(void);              //  I2C_Handler 
+void I2C_Async_Tick(void);             //  SysTick_Handler 
+
+#endif // __I2C_ASYNC_H__
@@ -5,6 +5,13 @@
 #include "Touch.h"
 #include "PageDesign.h"
 #include "event_handler.h"
+#include "event_queue.h"
+#include "scheduler.h"
+#include "systime.h"
+#include "prof.h"
+#ifdef M1_PROFILE
+#include "uart.h"
+#endif
 #include "fpga_registers.h"
 #include "ui_design_handler.h"
 
@@ -21,6 +28,118 @@
 volatile PageState_t currentPage = PAGE_MAIN;
 char display_str_buffer[64];
 
+// סڼ GT1151 Լÿ 10ms һε; ô () ûб͵Ѿɿ,
+// ֹɿǴα涪, һΰ± "ڰס" 
+#define TOUCH_RELEASE_TICKS 200
+
+static Touch_Data touch_report;            // 첽ȡĽ, ֻ I2C жд
+static volatile uint8_t  touch_down = 0;
+static volatile uint32_t touch_last_report = 0;
+static uint8_t touch_int_seen = 0;         // ϴδյ GT1151 INT
+
+// һЧĴ ( I2C ж): µһͶ EVT_TOUCH (¼,
+// ҳ洦ǰᱻһζ); ɿ֮ǰͶ, ҳ治Լжϱ
+static void Touch_Report(Touch_Data* tp)
+{
+    touch_last_report = Time_ms();
+    if (tp->Touch_Num > 0) {
+        if (!touch_down) Event_Post(EVT_TOUCH, EVT_TOUCH_ARG(tp->Tp_X[0], tp->Tp_Y[0]));
+        touch_down = 1;
+    } else {
+        touch_down = 0;
+    }
+}
+
+// ¼ǰҳ
+static void Dispatch_Page(const Event_t* evt)
+{
+    switch(currentPage) {
+        case PAGE_MAIN:          Handle_Main_Page(evt);       break;
+        case PAGE_WAVE_OUTPUT:   Handle_Wave_Out_Page(evt);   break;
+        case PAGE_ANALOG_INPUT:  Handle_Analog_In_Page(evt);  break;
+        case PAGE_DIGITAL_INPUT: Handle_Digital_In_Page(evt); break;
+        case PAGE_USB_CDC:       Handle_USB_CDC_Page(evt);    break;
+        default:
+            currentPage = PAGE_MAIN;
+            Display_Main_board();
+            break;
+    }
+}
+
+static void Page_Event(uint8_t type)
+{
+    Event_t evt;
+
+    evt.type  = type;
+    evt.arg   = Time_ms();
+    evt.stamp = FPGA_STAT_TICKS_REG;
+    Dispatch_Page(&evt);
+}
+
+// ---  ---
+//  (50Hz): յ INT һ I2C ȡ,  Touch_Report Ͷݴ¼;
+// ͬʱ鰴סʱ
+static void Touch_Task(void)
+{
+    if (touch_int_seen) {
+        touch_int_seen = 0;
+        GT1151_Scan_Async(&touch_report, 1, Touch_Report);
+    }
+    __disable_irq();
+    if (touch_down && Time_ms() - touch_last_report > TOUCH_RELEASE_TICKS) touch_down = 0;
+    __enable_irq();
+}
+
+// ҳѯ (100Hz): ͳƵӡ洢״̬дָûжϵ״̬
+static void Poll_Task(void)
+{
+    Page_Event(EVT_TICK);
+#ifdef M1_PROFILE
+    Prof_Command_Poll();
+#endif
+}
+
+//  (5Hz): ֻƱһ֡λ, ʱǰ֡
+static void Meas_Task(void)  { Page_Event(EVT_MEAS); }
+
+// ݾ¼: оʹ (Ϊ 0, ֻͳ).
+// ûв, ¼ Dispatch_Event  render_evt ٽ
+static Event_t render_evt;
+
+static void Render_Task(void) { Dispatch_Page(&render_evt); }
+
+// ˳ȼ
+enum { TASK_TOUCH, TASK_POLL, TASK_MEAS, TASK_RENDER, TASK_COUNT };
+Sched_Task_t sched_tasks[TASK_COUNT] = {
+    //       ()  
+    { "touch",   20,        Touch_Task  },
+    { "poll",    10,        Poll_Task   },
+    { "meas",    200,       Meas_Task   },
+    { "render",  0,         Render_Task },
+};
+
+static void Dispatch_Event(const Event_t* evt)
+{
+    switch (evt->type) {
+    case EVT_TICK:
+        // ˢϾʱĽĲ˻ûȡߵһ, evt->arg ǵһͶݵʱ, ѹȥʮ;
+        // ȡʱʵʱжϵںͳٵ
+        Sched_Tick(Time_ms());
+        break;
+    case EVT_TOUCH_INT:
+        touch_int_seen = 1;
+        break;
+    case EVT_TOUCH:
+        Touch_LCD.Tp_X[0] = EVT_TOUCH_X(evt->arg);
+        Touch_LCD.Tp_Y[0] = EVT_TOUCH_Y(evt->arg);
+        // fall through
+    default:
+        render_evt = *evt;
+        Sched_Run(&sched_tasks[TASK_RENDER]);
+        break;
+    }
+}
+
 
 // ============================================================================
 // Section 2:  main()
@@ -28,9 +147,20 @@ char display_str_buffer[64];
 int main(void)
 {
 	SystemInit();
+	Event_Queue_Init();
+	// ʱ׼ȿ: ʼʱ I2C дļʱ;
+	// ¼ǺϲͶݵ, ʼڼ䲻ѻ
+	Time_Init();
+	Sched_Init(sched_tasks, TASK_COUNT, Time_ms());
+	FPGA_IRQ_Init();
+#ifdef M1_PROFILE
+	UartInit();             // ͳƴ UART0 
+#else
 	//UartInit();
+#endif
 	//GPIOInit();
 	GT1151_Init();
+	GT1151_INT_Init();
 	mcu_lcd_reg_init();
 	
 	brush_color = LCD_BLACK;
@@ -42,17 +172,18 @@ int main(void)
 	Display_Main_board();
 
 	while(1) {
-		switch(currentPage) {
-            case PAGE_MAIN:          Handle_Main_Page();       break;
-            case PAGE_WAVE_OUTPUT:   Handle_Wave_Out_Page();   break;
-            case PAGE_ANALOG_INPUT:  Handle_Analog_In_Page();  break;
-            case PAGE_DIGITAL_INPUT: Handle_Digital_In_Page(); break;
-						case PAGE_USB_CDC: 			 Handle_USB_CDC_Page(); 	 break;
-            default:
-                currentPage = PAGE_MAIN;
-                Display_Main_board();
-                break;
-        }
+		Event_t evt;
+
+		if (Event_Get(&evt)) {
+			Dispatch_Event(&evt);
+			Event_Done(&evt);
+			continue;
+		}
+		// п: жϺȷһ˯, жϹʱ WFI ,
+		//  "ΪաжͶ¼ȻŽ WFI" ˯һ
+		__disable_irq();
+		if (Event_Queue_Empty()) __WFI();
+		__enable_irq();
 	}
 }
 
@@ -0,0 +1,87 @@
+#include "prof.h"
+
+#ifdef M1_PROFILE
+
+#include <stdio.h>
+#include <string.h>
+#include "GOWIN_M1.h"
+#include "systime.h"
+
+Prof_Stat_t prof_stats[PROF_REGION_COUNT];
+
+static const char* const prof_names[PROF_REGION_COUNT] = {
+    "scope_grid",
+    "scope_waveform",
+    "touch_scan",
+    "analog_copy",
+    "digital_analyze",
+};
+
+void Prof_Start(uint8_t id)
+{
+    prof_stats[id].start = Time_Cycles();
+}
+
+// û CLZ ָ (ARMv6-M),  2 λҵλ,  15 
+void Prof_Stop(uint8_t id)
+{
+    Prof_Stat_t* s = &prof_stats[id];
+    uint32_t cycles = Time_Cycles() - s->start;
+    uint32_t v = cycles >> 7;
+    int bin = 0;
+
+    while (v && bin < PROF_HIST_BINS - 1) {
+        v >>= 1;
+        bin++;
+    }
+    s->hist[bin]++;
+    if (s->count == 0 || cycles < s->min) s->min = cycles;
+    if (cycles > s->max) s->max = cycles;
+    s->total += cycles;
+    s->count++;
+}
+
+void Prof_Reset(void)
+{
+    memset(prof_stats, 0, sizeof(prof_stats));
+}
+
+// ʱ任 us ӡ; ֱͼÿֻӡ, ͷ ()
+void Prof_Dump(void)
+{
+    uint32_t cyc_per_us = SystemCoreClock / 1000000;
+    int i, k;
+
+    printf("\r\nregion            count     min_us     avg_us     max_us\r\n");
+    for (i = 0; i < PROF_REGION_COUNT; i++) {
+        Prof_Stat_t* s = &prof_stats[i];
+        uint32_t avg = s->count ? (uint32_t)(s->total / s->count) : 0;
+        printf("%-16s %6lu %10lu %10lu %10lu\r\n", prof_names[i], (unsigned long)s->count,
+               (unsigned long)(s->min / cyc_per_us), (unsigned long)(avg / cyc_per_us),
+               (unsigned long)(s->max / cyc_per_us));
+    }
+
+    printf("\r\nhistogram (cycles >=)\r\n%-16s", "");
+    for (k = 0; k < PROF_HIST_BINS; k++)
+        printf(" %6lu", k ? (unsigned long)(64UL << k) : 0UL);
+    printf("\r\n");
+    for (i = 0; i < PROF_REGION_COUNT; i++) {
+        printf("%-16s", prof_names[i]);
+        for (k = 0; k < PROF_HIST_BINS; k++)
+            printf(" %6lu", (unsigned long)prof_stats[i].hist[k]);
+        printf("\r\n");
+    }
+}
+
+// ӡڼ fputc ֽڵȷ, һűԼ 1.5KB (115200 Լ 130ms), ֻյʱ
+void Prof_Command_Poll(void)
+{
+    char c;
+
+    if (!(UART0->STATE & UART_STATE_RXBF)) return;
+    c = (char)UART_ReceiveChar(UART0);
+    if (c == 'p') Prof_Dump();
+    else if (c == 'r') Prof_Reset();
+}
+
+#endif // M1_PROFILE
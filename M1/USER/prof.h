@@ -0,0 +1,59 @@
+#ifndef __PROF_H__
+#define __PROF_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  κʱͳ ().
+//  PROF_START(id) / PROF_STOP(id) ֮ĺʱ Time_Cycles() (SysTick ǰֵ
+//  Ӻ)  HCLK Ϊλ, ÿۼƴС//ƽֱֵͼ.
+//  ֱͼ 2 ݷֵ:  0  < 128 ,  k  [2^(k+6), 2^(k+7)), һ.
+//
+//  ͳƱ,  START  STOP ڲͬ (첽 I2C ύɻص);
+//  ͬһβǶ.
+//
+//  ڹ̵Ԥﶨ M1_PROFILE ű ( LCD_BUS_STAT ͬ), Ϊ.
+//   (UART0, 115200) յ 'p' ӡͳƱ, յ 'r' , ѭѯ.
+// ============================================================================
+
+typedef enum {
+    PROF_SCOPE_GRID,       // Draw_Scope_Grid
+    PROF_SCOPE_WAVEFORM,   // Draw_Scope_Waveform
+    PROF_TOUCH_SCAN,       // GT1151 첽һδ (ύ)
+    PROF_ANALOG_COPY,      // ģͨ֡ (AHB  + ۼ)
+    PROF_DIGITAL_ANALYZE,  // Analyze_and_Display_Signal
+    PROF_REGION_COUNT
+} Prof_Region_t;
+
+#define PROF_HIST_BINS 16
+
+typedef struct {
+    uint32_t start;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[PROF_HIST_BINS];
+} Prof_Stat_t;
+
+#ifdef M1_PROFILE
+
+extern Prof_Stat_t prof_stats[PROF_REGION_COUNT];
+
+void Prof_Start(uint8_t id);
+void Prof_Stop(uint8_t id);
+void Prof_Reset(void);
+void Prof_Dump(void);              // printf  UART0
+void Prof_Command_Poll(void);      // 鴮
+
+#define PROF_START(id)  Prof_Start(id)
+#define PROF_STOP(id)   Prof_Stop(id)
+
+#else
+
+#define PROF_START(id)  ((void)0)
+#define PROF_STOP(id)   ((void)0)
+
+#endif // M1_PROFILE
+
+#endif // __PROF_H__
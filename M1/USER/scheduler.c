@@ -0,0 +1,49 @@
+#include "scheduler.h"
+#include "fpga_registers.h"
+
+static Sched_Task_t* sched_tasks = 0;
+static uint8_t sched_count = 0;
+
+void Sched_Init(Sched_Task_t* tasks, uint8_t count, uint32_t now)
+{
+    sched_tasks = tasks;
+    sched_count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        tasks[i].next  = now + tasks[i].period;
+        tasks[i].count = 0;
+        tasks[i].late  = 0;
+        tasks[i].last  = 0;
+        tasks[i].max   = 0;
+        tasks[i].total = 0;
+    }
+}
+
+void Sched_Run(Sched_Task_t* task)
+{
+    uint32_t start = FPGA_STAT_TICKS_REG;
+    uint32_t cost;
+
+    task->run();
+    cost = FPGA_STAT_TICKS_REG - start;
+    task->count++;
+    task->last   = cost;
+    task->total += cost;
+    if (cost > task->max) task->max = cost;
+}
+
+void Sched_Tick(uint32_t now)
+{
+    for (uint8_t i = 0; i < sched_count; i++) {
+        Sched_Task_t* t = &sched_tasks[i];
+
+        if (t->period == 0 || (int32_t)(now - t->next) < 0) continue;
+        // ǰ (ˢ) ռ̫, ˲ֹһ: 
+        if ((int32_t)(now - t->next) >= t->period) {
+            t->late++;
+            t->next = now + t->period;
+        } else {
+            t->next += t->period;
+        }
+        Sched_Run(t);
+    }
+}
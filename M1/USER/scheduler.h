@@ -0,0 +1,34 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  SysTick Эʽ.
+//  ȼ (пǰ). ÿ EVT_TICK  Sched_Tick еڵ
+//  , ÿеΪֹ, ռ. Ϊ 0 񲻰,
+//  ʾ¼Ĺ (ݾʹ), ÷ Sched_Run вͳ.
+//
+//  ͳƵλΪ HCLK  (FPGA_STAT_TICKS_REG),  SysTick ֱ:
+//  дһΡһΡۼƺʱ; ʱһλûֵ (һ) һ late,
+//  ʱ, ֱӴӵǰ¼.
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    uint16_t period;           //  (), 0 = ¼
+    void (*run)(void);
+    // ɵά
+    uint32_t next;             // ´εڵĽ
+    uint32_t count;
+    uint32_t late;
+    uint32_t last;             // HCLK 
+    uint32_t max;
+    uint64_t total;
+} Sched_Task_t;
+
+void Sched_Init(Sched_Task_t* tasks, uint8_t count, uint32_t now);
+void Sched_Tick(uint32_t now);             //  EVT_TICK ϵ
+void Sched_Run(Sched_Task_t* task);        // һ񲢼ͳ (¼)
+
+#endif // __SCHEDULER_H__
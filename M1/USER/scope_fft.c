@@ -0,0 +1,71 @@
+#include "scope_fft.h"
+
+// Q15 ˷, 
+#define Q15_MUL(a, b)  ((int16_t)(((int32_t)(a) * (b) + 0x4000) >> 15))
+
+void Scope_FFT_Window(int16_t* x, int log2n)
+{
+    const int n = 1 << log2n;
+    const int step = 1 << (SCOPE_FFT_LOG2N - log2n);
+
+    for (int i = 0; i < n; i++)
+        x[i] = Q15_MUL(x[i], scope_fft_hann[i * step]);
+}
+
+void Scope_FFT_Q15(int16_t* re, int16_t* im, int log2n)
+{
+    const int n = 1 << log2n;
+    const int rev_shift = SCOPE_FFT_LOG2N - log2n;
+    int16_t t;
+
+    // 1. λת (ÿֻһ)
+    for (int i = 0; i < n; i++) {
+        int j = scope_fft_bitrev[i] >> rev_shift;
+        if (j > i) {
+            t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    // 2. 𼶵: W = cos - j*sin, ͬһת, ֻһ
+    int tw_step = SCOPE_FFT_N >> 1;                  // תڱеĲ = N / (2*half)
+    for (int half = 1; half < n; half <<= 1, tw_step >>= 1) {
+        for (int k = 0; k < half; k++) {
+            const int32_t wr = scope_fft_cos[k * tw_step];
+            const int32_t wi = scope_fft_sin[k * tw_step];
+
+            for (int a = k; a < n; a += half << 1) {
+                const int b = a + half;
+                // (re[b] + j*im[b]) * (wr - j*wi)
+                int32_t tr = ((int32_t)re[b] * wr + (int32_t)im[b] * wi + 0x4000) >> 15;
+                int32_t ti = ((int32_t)im[b] * wr - (int32_t)re[b] * wi + 0x4000) >> 15;
+                int32_t ar = re[a], ai = im[a];
+
+                re[a] = (int16_t)((ar + tr) >> 1);
+                im[a] = (int16_t)((ai + ti) >> 1);
+                re[b] = (int16_t)((ar - tr) >> 1);
+                im[b] = (int16_t)((ai - ti) >> 1);
+            }
+        }
+    }
+}
+
+int16_t Scope_FFT_Power_dB(uint32_t p)
+{
+    uint32_t v = p;
+    int e = 0, m;
+
+    if (p == 0) return -9999;
+
+    // λ (ARMv6-M û CLZ, λ)
+    if (v >= 1UL << 16) { v >>= 16; e += 16; }
+    if (v >= 1UL << 8)  { v >>= 8;  e += 8; }
+    if (v >= 1UL << 4)  { v >>= 4;  e += 4; }
+    if (v >= 1UL << 2)  { v >>= 2;  e += 2; }
+    if (v >= 1UL << 1)  { e += 1; }
+
+    // λ֮ 5 λ
+    m = (e >= 5) ? (int)((p >> (e - 5)) & 31) : (int)((p << (5 - e)) & 31);
+
+    return (int16_t)(scope_fft_db_exp[e] + scope_fft_db_mant[m] - SCOPE_FFT_DB_FS);
+}
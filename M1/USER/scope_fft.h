@@ -0,0 +1,37 @@
+#ifndef __SCOPE_FFT_H__
+#define __SCOPE_FFT_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//   FFT (Ƶʾ)
+//  -  2 ʱȡ, ԭλ, Q15 , ÿκ 1 λ ( = X[k]/n), 
+//  - תӡλתHann dB  M1/HOST/gen_fft_tables.py  (scope_fft_tables.c)
+//  -  512 , Ϊ 2 ʱֱͬһױ (ȡ)
+//  Cortex-M1 ûӲ, ֻг˷λͲ.
+// ============================================================================
+
+#define SCOPE_FFT_N      512
+#define SCOPE_FFT_LOG2N  9
+
+//  ( 32768,  Hann ) ķֵ bin  = 8192^2 = 2^26, Ӧ 78.3dB;
+// Scope_FFT_Power_dB ȥ, ҵķֵ 0dB
+#define SCOPE_FFT_DB_FS  (783)
+
+extern const int16_t  scope_fft_cos[SCOPE_FFT_N / 2];
+extern const int16_t  scope_fft_sin[SCOPE_FFT_N / 2];
+extern const uint16_t scope_fft_bitrev[SCOPE_FFT_N];
+extern const int16_t  scope_fft_hann[SCOPE_FFT_N];
+extern const int16_t  scope_fft_db_exp[32];
+extern const int16_t  scope_fft_db_mant[32];
+
+// ԭλ FFT: re/im  2^log2n  Q15  (log2n <= SCOPE_FFT_LOG2N), Ϊ X[k]/n
+void Scope_FFT_Q15(int16_t* re, int16_t* im, int log2n);
+
+//  Hann : x[i] *= w[i],  2^log2n
+void Scope_FFT_Window(int16_t* x, int log2n);
+
+//  re^2+im^2 -> ҵ dB, λ 0.1dB (p = 0 ʱ -999.9dB)
+int16_t Scope_FFT_Power_dB(uint32_t p);
+
+#endif // __SCOPE_FFT_H__
@@ -0,0 +1,164 @@
+// ============================================================================
+//   M1/HOST/gen_fft_tables.py , ֹ޸.
+//  512  Q15 FFT ñ, ȫΪ const, ӵ flash.
+// ============================================================================
+#include "scope_fft.h"
+
+// cos(2*pi*k/N), k = 0..N/2-1
+const int16_t scope_fft_cos[SCOPE_FFT_N / 2] = {
+     32767,  32766,  32758,  32746,  32729,  32706,  32679,  32647,  32610,  32568,  32522,  32470,
+     32413,  32352,  32286,  32214,  32138,  32058,  31972,  31881,  31786,  31686,  31581,  31471,
+     31357,  31238,  31114,  30986,  30853,  30715,  30572,  30425,  30274,  30118,  29957,  29792,
+     29622,  29448,  29269,  29086,  28899,  28707,  28511,  28311,  28106,  27897,  27684,  27467,
+     27246,  27020,  26791,  26557,  26320,  26078,  25833,  25583,  25330,  25073,  24812,  24548,
+     24279,  24008,  23732,  23453,  23170,  22884,  22595,  22302,  22006,  21706,  21403,  21097,
+     20788,  20475,  20160,  19841,  19520,  19195,  18868,  18538,  18205,  17869,  17531,  17190,
+     16846,  16500,  16151,  15800,  15447,  15091,  14733,  14373,  14010,  13646,  13279,  12910,
+     12540,  12167,  11793,  11417,  11039,  10660,  10279,   9896,   9512,   9127,   8740,   8351,
+      7962,   7571,   7180,   6787,   6393,   5998,   5602,   5205,   4808,   4410,   4011,   3612,
+      3212,   2811,   2411,   2009,   1608,   1206,    804,    402,      0,   -402,   -804,  -1206,
+     -1608,  -2009,  -2411,  -2811,  -3212,  -3612,  -4011,  -4410,  -4808,  -5205,  -5602,  -5998,
+     -6393,  -6787,  -7180,  -7571,  -7962,  -8351,  -8740,  -9127,  -9512,  -9896, -10279, -10660,
+    -11039, -11417, -11793, -12167, -12540, -12910, -13279, -13646, -14010, -14373, -14733, -15091,
+    -15447, -15800, -16151, -16500, -16846, -17190, -17531, -17869, -18205, -18538, -18868, -19195,
+    -19520, -19841, -20160, -20475, -20788, -21097, -21403, -21706, -22006, -22302, -22595, -22884,
+    -23170, -23453, -23732, -24008, -24279, -24548, -24812, -25073, -25330, -25583, -25833, -26078,
+    -26320, -26557, -26791, -27020, -27246, -27467, -27684, -27897, -28106, -28311, -28511, -28707,
+    -28899, -29086, -29269, -29448, -29622, -29792, -29957, -30118, -30274, -30425, -30572, -30715,
+    -30853, -30986, -31114, -31238, -31357, -31471, -31581, -31686, -31786, -31881, -31972, -32058,
+    -32138, -32214, -32286, -32352, -32413, -32470, -32522, -32568, -32610, -32647, -32679, -32706,
+    -32729, -32746, -32758, -32766,
+};
+
+// sin(2*pi*k/N), k = 0..N/2-1
+const int16_t scope_fft_sin[SCOPE_FFT_N / 2] = {
+         0,    402,    804,   1206,   1608,   2009,   2411,   2811,   3212,   3612,   4011,   4410,
+      4808,   5205,   5602,   5998,   6393,   6787,   7180,   7571,   7962,   8351,   8740,   9127,
+      9512,   9896,  10279,  10660,  11039,  11417,  11793,  12167,  12540,  12910,  13279,  13646,
+     14010,  14373,  14733,  15091,  15447,  15800,  16151,  16500,  16846,  17190,  17531,  17869,
+     18205,  18538,  18868,  19195,  19520,  19841,  20160,  20475,  20788,  21097,  21403,  21706,
+     22006,  22302,  22595,  22884,  23170,  23453,  23732,  24008,  24279,  24548,  24812,  25073,
+     25330,  25583,  25833,  26078,  26320,  26557,  26791,  27020,  27246,  27467,  27684,  27897,
+     28106,  28311,  28511,  28707,  28899,  29086,  29269,  29448,  29622,  29792,  29957,  30118,
+     30274,  30425,  30572,  30715,  30853,  30986,  31114,  31238,  31357,  31471,  31581,  31686,
+     31786,  31881,  31972,  32058,  32138,  32214,  32286,  32352,  32413,  32470,  32522,  32568,
+     32610,  32647,  32679,  32706,  32729,  32746,  32758,  32766,  32767,  32766,  32758,  32746,
+     32729,  32706,  32679,  32647,  32610,  32568,  32522,  32470,  32413,  32352,  32286,  32214,
+     32138,  32058,  31972,  31881,  31786,  31686,  31581,  31471,  31357,  31238,  31114,  30986,
+     30853,  30715,  30572,  30425,  30274,  30118,  29957,  29792,  29622,  29448,  29269,  29086,
+     28899,  28707,  28511,  28311,  28106,  27897,  27684,  27467,  27246,  27020,  26791,  26557,
+     26320,  26078,  25833,  25583,  25330,  25073,  24812,  24548,  24279,  24008,  23732,  23453,
+     23170,  22884,  22595,  22302,  22006,  21706,  21403,  21097,  20788,  20475,  20160,  19841,
+     19520,  19195,  18868,  18538,  18205,  17869,  17531,  17190,  16846,  16500,  16151,  15800,
+     15447,  15091,  14733,  14373,  14010,  13646,  13279,  12910,  12540,  12167,  11793,  11417,
+     11039,  10660,  10279,   9896,   9512,   9127,   8740,   8351,   7962,   7571,   7180,   6787,
+      6393,   5998,   5602,   5205,   4808,   4410,   4011,   3612,   3212,   2811,   2411,   2009,
+      1608,   1206,    804,    402,
+};
+
+// 9 λλת; Ϊ N/2^s ʱȡ scope_fft_bitrev[i] >> s
+const uint16_t scope_fft_bitrev[SCOPE_FFT_N] = {
+         0,    256,    128,    384,     64,    320,    192,    448,     32,    288,    160,    416,
+        96,    352,    224,    480,     16,    272,    144,    400,     80,    336,    208,    464,
+        48,    304,    176,    432,    112,    368,    240,    496,      8,    264,    136,    392,
+        72,    328,    200,    456,     40,    296,    168,    424,    104,    360,    232,    488,
+        24,    280,    152,    408,     88,    344,    216,    472,     56,    312,    184,    440,
+       120,    376,    248,    504,      4,    260,    132,    388,     68,    324,    196,    452,
+        36,    292,    164,    420,    100,    356,    228,    484,     20,    276,    148,    404,
+        84,    340,    212,    468,     52,    308,    180,    436,    116,    372,    244,    500,
+        12,    268,    140,    396,     76,    332,    204,    460,     44,    300,    172,    428,
+       108,    364,    236,    492,     28,    284,    156,    412,     92,    348,    220,    476,
+        60,    316,    188,    444,    124,    380,    252,    508,      2,    258,    130,    386,
+        66,    322,    194,    450,     34,    290,    162,    418,     98,    354,    226,    482,
+        18,    274,    146,    402,     82,    338,    210,    466,     50,    306,    178,    434,
+       114,    370,    242,    498,     10,    266,    138,    394,     74,    330,    202,    458,
+        42,    298,    170,    426,    106,    362,    234,    490,     26,    282,    154,    410,
+        90,    346,    218,    474,     58,    314,    186,    442,    122,    378,    250,    506,
+         6,    262,    134,    390,     70,    326,    198,    454,     38,    294,    166,    422,
+       102,    358,    230,    486,     22,    278,    150,    406,     86,    342,    214,    470,
+        54,    310,    182,    438,    118,    374,    246,    502,     14,    270,    142,    398,
+        78,    334,    206,    462,     46,    302,    174,    430,    110,    366,    238,    494,
+        30,    286,    158,    414,     94,    350,    222,    478,     62,    318,    190,    446,
+       126,    382,    254,    510,      1,    257,    129,    385,     65,    321,    193,    449,
+        33,    289,    161,    417,     97,    353,    225,    481,     17,    273,    145,    401,
+        81,    337,    209,    465,     49,    305,    177,    433,    113,    369,    241,    497,
+         9,    265,    137,    393,     73,    329,    201,    457,     41,    297,    169,    425,
+       105,    361,    233,    489,     25,    281,    153,    409,     89,    345,    217,    473,
+        57,    313,    185,    441,    121,    377,    249,    505,      5,    261,    133,    389,
+        69,    325,    197,    453,     37,    293,    165,    421,    101,    357,    229,    485,
+        21,    277,    149,    405,     85,    341,    213,    469,     53,    309,    181,    437,
+       117,    373,    245,    501,     13,    269,    141,    397,     77,    333,    205,    461,
+        45,    301,    173,    429,    109,    365,    237,    493,     29,    285,    157,    413,
+        93,    349,    221,    477,     61,    317,    189,    445,    125,    381,    253,    509,
+         3,    259,    131,    387,     67,    323,    195,    451,     35,    291,    163,    419,
+        99,    355,    227,    483,     19,    275,    147,    403,     83,    339,    211,    467,
+        51,    307,    179,    435,    115,    371,    243,    499,     11,    267,    139,    395,
+        75,    331,    203,    459,     43,    299,    171,    427,    107,    363,    235,    491,
+        27,    283,    155,    411,     91,    347,    219,    475,     59,    315,    187,    443,
+       123,    379,    251,    507,      7,    263,    135,    391,     71,    327,    199,    455,
+        39,    295,    167,    423,    103,    359,    231,    487,     23,    279,    151,    407,
+        87,    343,    215,    471,     55,    311,    183,    439,    119,    375,    247,    503,
+        15,    271,    143,    399,     79,    335,    207,    463,     47,    303,    175,    431,
+       111,    367,    239,    495,     31,    287,    159,    415,     95,    351,    223,    479,
+        63,    319,    191,    447,    127,    383,    255,    511,
+};
+
+// Hann  0.5 - 0.5*cos(2*pi*i/N); Ϊ N/2^s ʱ 2^s ȡһ
+const int16_t scope_fft_hann[SCOPE_FFT_N] = {
+         0,      1,      5,     11,     20,     31,     44,     60,     79,    100,    123,    149,
+       177,    208,    241,    277,    315,    355,    398,    443,    491,    541,    593,    648,
+       705,    765,    827,    891,    958,   1027,   1098,   1171,   1247,   1325,   1406,   1488,
+      1573,   1660,   1749,   1841,   1935,   2030,   2128,   2229,   2331,   2435,   2542,   2651,
+      2761,   2874,   2989,   3105,   3224,   3345,   3468,   3592,   3719,   3847,   3978,   4110,
+      4244,   4380,   4518,   4657,   4799,   4942,   5087,   5233,   5381,   5531,   5682,   5835,
+      5990,   6146,   6304,   6463,   6624,   6786,   6950,   7115,   7282,   7449,   7619,   7789,
+      7961,   8134,   8308,   8484,   8661,   8839,   9018,   9198,   9379,   9561,   9745,   9929,
+     10114,  10300,  10487,  10676,  10864,  11054,  11245,  11436,  11628,  11821,  12014,  12208,
+     12403,  12598,  12794,  12991,  13188,  13385,  13583,  13781,  13980,  14179,  14378,  14578,
+     14778,  14978,  15179,  15379,  15580,  15781,  15982,  16183,  16384,  16585,  16786,  16987,
+     17188,  17389,  17589,  17790,  17990,  18190,  18390,  18589,  18788,  18987,  19185,  19383,
+     19580,  19777,  19974,  20170,  20365,  20560,  20754,  20947,  21140,  21332,  21523,  21714,
+     21904,  22092,  22281,  22468,  22654,  22839,  23023,  23207,  23389,  23570,  23750,  23929,
+     24107,  24284,  24460,  24634,  24807,  24979,  25149,  25319,  25486,  25653,  25818,  25982,
+     26144,  26305,  26464,  26622,  26778,  26933,  27086,  27237,  27387,  27535,  27681,  27826,
+     27969,  28111,  28250,  28388,  28524,  28658,  28790,  28921,  29049,  29176,  29300,  29423,
+     29544,  29663,  29779,  29894,  30007,  30117,  30226,  30333,  30437,  30539,  30640,  30738,
+     30833,  30927,  31019,  31108,  31195,  31280,  31362,  31443,  31521,  31597,  31670,  31741,
+     31810,  31877,  31941,  32003,  32063,  32120,  32175,  32227,  32277,  32325,  32370,  32413,
+     32453,  32491,  32527,  32560,  32591,  32619,  32645,  32668,  32689,  32708,  32724,  32737,
+     32748,  32757,  32763,  32767,  32767,  32767,  32763,  32757,  32748,  32737,  32724,  32708,
+     32689,  32668,  32645,  32619,  32591,  32560,  32527,  32491,  32453,  32413,  32370,  32325,
+     32277,  32227,  32175,  32120,  32063,  32003,  31941,  31877,  31810,  31741,  31670,  31597,
+     31521,  31443,  31362,  31280,  31195,  31108,  31019,  30927,  30833,  30738,  30640,  30539,
+     30437,  30333,  30226,  30117,  30007,  29894,  29779,  29663,  29544,  29423,  29300,  29176,
+     29049,  28921,  28790,  28658,  28524,  28388,  28250,  28111,  27969,  27826,  27681,  27535,
+     27387,  27237,  27086,  26933,  26778,  26622,  26464,  26305,  26144,  25982,  25818,  25653,
+     25486,  25319,  25149,  24979,  24807,  24634,  24460,  24284,  24107,  23929,  23750,  23570,
+     23389,  23207,  23023,  22839,  22654,  22468,  22281,  22092,  21904,  21714,  21523,  21332,
+     21140,  20947,  20754,  20560,  20365,  20170,  19974,  19777,  19580,  19383,  19185,  18987,
+     18788,  18589,  18390,  18190,  17990,  17790,  17589,  17389,  17188,  16987,  16786,  16585,
+     16384,  16183,  15982,  15781,  15580,  15379,  15179,  14978,  14778,  14578,  14378,  14179,
+     13980,  13781,  13583,  13385,  13188,  12991,  12794,  12598,  12403,  12208,  12014,  11821,
+     11628,  11436,  11245,  11054,  10864,  10676,  10487,  10300,  10114,   9929,   9745,   9561,
+      9379,   9198,   9018,   8839,   8661,   8484,   8308,   8134,   7961,   7789,   7619,   7449,
+      7282,   7115,   6950,   6786,   6624,   6463,   6304,   6146,   5990,   5835,   5682,   5531,
+      5381,   5233,   5087,   4942,   4799,   4657,   4518,   4380,   4244,   4110,   3978,   3847,
+      3719,   3592,   3468,   3345,   3224,   3105,   2989,   2874,   2761,   2651,   2542,   2435,
+      2331,   2229,   2128,   2030,   1935,   1841,   1749,   1660,   1573,   1488,   1406,   1325,
+      1247,   1171,   1098,   1027,    958,    891,    827,    765,    705,    648,    593,    541,
+       491,    443,    398,    355,    315,    277,    241,    208,    177,    149,    123,    100,
+        79,     60,     44,     31,     20,     11,      5,      1,
+};
+
+//  -> dB: 10*log10(p) = db_exp[λ] + db_mant[λ֮ 5 λ], λ 0.1dB
+const int16_t scope_fft_db_exp[32] = {
+         0,     30,     60,     90,    120,    151,    181,    211,    241,    271,    301,    331,
+       361,    391,    421,    452,    482,    512,    542,    572,    602,    632,    662,    692,
+       722,    753,    783,    813,    843,    873,    903,    933,
+};
+
+const int16_t scope_fft_db_mant[32] = {
+         1,      2,      3,      5,      6,      7,      8,      9,     10,     11,     12,     13,
+        14,     15,     16,     17,     18,     19,     20,     21,     22,     22,     23,     24,
+        25,     25,     26,     27,     28,     28,     29,     30,
+};
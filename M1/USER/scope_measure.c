@@ -0,0 +1,61 @@
+#include "scope_measure.h"
+#include "event_handler.h"
+
+// Q8.4 -> mV: ֵ 1 = ADC_FSR_MV/128, ٳ 16
+#define Q4_TO_MV(q)  (((q) * ADC_FSR_MV) >> 11)
+
+// λ, ûг
+static uint32_t isqrt32(uint32_t x)
+{
+    uint32_t root = 0, bit = 1UL << 30;
+
+    while (bit > x) bit >>= 2;
+    while (bit) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void Scope_Meas_Begin(Scope_Meas* m)
+{
+    if (m->index > 0) {
+        m->level = (m->min + m->max) >> 1;
+        m->hyst  = (m->max - m->min) >> 3;
+    }
+    if (m->hyst < 32) m->hyst = 32;      //  2 , شԽ
+
+    m->min = 0x7FFFFFFF;
+    m->max = -0x7FFFFFFF;
+    m->sum = 0;
+    m->sum_sq = 0;
+    m->first = -1;
+    m->last = -1;
+    m->crossings = 0;
+    m->index = 0;
+    m->armed = 0;
+}
+
+void Scope_Meas_Finish(Scope_Meas* m, Scope_Meas_Result* r)
+{
+    int shift = 0;
+
+    if (m->index <= 0) {
+        r->vmin_mv = r->vmax_mv = r->vavg_mv = r->vrms_mv = 0;
+        r->cycles = r->span = 0;
+        return;
+    }
+    while ((1L << shift) < m->index) shift++;
+
+    r->vmin_mv = Q4_TO_MV(m->min);
+    r->vmax_mv = Q4_TO_MV(m->max);
+    r->vavg_mv = Q4_TO_MV(m->sum >> shift);
+    r->vrms_mv = Q4_TO_MV((int32_t)isqrt32(m->sum_sq >> shift));
+    r->cycles  = (m->crossings > 1) ? m->crossings - 1 : 0;
+    r->span    = m->last - m->first;
+}
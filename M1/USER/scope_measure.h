@@ -0,0 +1,63 @@
+#ifndef __SCOPE_MEASURE_H__
+#define __SCOPE_MEASURE_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  β: ڿ FPGA ѭۼ, ֻһ.
+//  ͳһ 0V (ADC  128) Ϊз Q8.4 (1 LSB = 1/16 ),
+//  8 λ 4 λ, ƽʽ Q8.8  4 λ, Ҳ 32 λ:
+//  |s| <= 2048, 512 ƽ <= 2^31.
+//  ȫ̶, ֻ Scope_Meas_Finish λֵ, λ.
+// ============================================================================
+
+typedef struct {
+    int32_t  min, max;        // ֡С/ֵ (Q8.4)
+    int32_t  sum;             // ֡ۼӺ
+    uint32_t sum_sq;          // ֡ƽ
+    int32_t  level, hyst;     // жƽͻز: ȡһֵ֡ͷֵ/8
+    int32_t  first, last;     // һ/һԽĵ, -1 ʾû
+    int32_t  crossings;       // Խ
+    int32_t  index;           // ۼӵĵ
+    uint8_t  armed;
+} Scope_Meas;
+
+typedef struct {
+    int32_t vmin_mv, vmax_mv; // С/ֵ
+    int32_t vavg_mv;          // ƽֵ
+    int32_t vrms_mv;          // Чֵ (ֱ)
+    int32_t cycles;           // first..last ֮, 0 ʾⲻƵ
+    int32_t span;             // first..last ֮ĵ
+} Scope_Meas_Result;
+
+// һ֡ʼ: һ֡ƽ, ۼ (״ʹǰѽṹ㼴)
+void Scope_Meas_Begin(Scope_Meas* m);
+
+// һ: lo/hi С/ֵ, s ھֵЧֵ͹ (ȡ/ƽʽͬ)
+static inline void Scope_Meas_Add_Span(Scope_Meas* m, int32_t lo, int32_t hi, int32_t s)
+{
+    if (lo < m->min) m->min = lo;
+    if (hi > m->max) m->max = hi;
+    m->sum    += s;
+    m->sum_sq += (uint32_t)(s * s);
+
+    if (!m->armed) {
+        if (s < m->level - m->hyst) m->armed = 1;
+    } else if (s >= m->level) {
+        m->armed = 0;
+        if (m->first < 0) m->first = m->index;
+        m->last = m->index;
+        m->crossings++;
+    }
+    m->index++;
+}
+
+static inline void Scope_Meas_Add(Scope_Meas* m, int32_t s)
+{
+    Scope_Meas_Add_Span(m, s, s, s);
+}
+
+// һ֡: ɺ, Ϊ 2  (512/256)
+void Scope_Meas_Finish(Scope_Meas* m, Scope_Meas_Result* r);
+
+#endif // __SCOPE_MEASURE_H__
@@ -0,0 +1,31 @@
+#include "scope_trigger.h"
+
+int Scope_Trigger_Find(const uint8_t* buf, int count, int stride, int from, int to,
+                       const Scope_Trigger* trig)
+{
+    // ½ذ͵ƽȡ (v -> 255-v), ͱ, бʹһѭ
+    const int flip  = trig->falling ? 0xFF : 0x00;
+    const int level = trig->level ^ flip;
+    const int arm   = level - trig->hyst;   //  < arm ʱװ, Ϊ (װ)
+    int armed = 0;
+    int last  = -1;                         // һαܵĴ
+    int i;
+
+    if (to > count) to = count;
+
+    for (i = 0; i < to; i++, buf += stride)
+    {
+        int v = *buf ^ flip;
+
+        if (armed && v >= level) {
+            armed = 0;
+            if (last < 0 || i - last >= trig->holdoff) {
+                if (i >= from) return i;
+                last = i;
+            }
+        } else if (v < arm) {
+            armed = 1;
+        }
+    }
+    return -1;
+}
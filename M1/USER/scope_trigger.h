@@ -0,0 +1,27 @@
+#ifndef __SCOPE_TRIGGER_H__
+#define __SCOPE_TRIGGER_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  : һ֡ҵƽԽ, ڰѲζ뵽̶Ĵλ.
+//   FPGA Ӳ (ANALOG_TRIG_REG) жͬ:
+//    :  + ز < ƽ ʱװ, װ >= ƽ ;
+//    ½:  > ƽ + ز ʱװ, װ <= ƽ .
+//  ɨ, ֻбȽϺͼӼ, ûг.
+// ============================================================================
+
+typedef struct {
+    uint8_t  level;      // ƽ (ADC ֵ)
+    uint8_t  hyst;       // ز
+    uint8_t  falling;    // 0=, 1=½
+    uint16_t holdoff;    // : һδٸٸŽһδ
+} Scope_Trigger;
+
+//  buf[0], buf[stride], buf[2*stride] ...  count , صһ [from, to) ڵĴ;
+// from ֮ǰĵճװ. ûҵ -1.
+// stride ڷֵ/ƽʽ: ֵȡ min  max ֽ, Q8.8 ȡ (ֽ).
+int Scope_Trigger_Find(const uint8_t* buf, int count, int stride, int from, int to,
+                       const Scope_Trigger* trig);
+
+#endif // __SCOPE_TRIGGER_H__
@@ -0,0 +1,89 @@
+#include "systime.h"
+#include "GOWIN_M1.h"
+
+volatile uint32_t g_tick_count = 0;
+// ÿ HCLK ڵ΢, Q16  (1/50 * 65536, ), Time_Init  SystemCoreClock ¼.
+// M1 ûӲ, Time_us æѭﷴ, ó˷λÿε
+static uint32_t us_per_cycle_q16 = 1311;
+
+void Time_Init(void)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+
+    us_per_cycle_q16 = (65536 + cycles_per_us / 2) / cycles_per_us;
+    SysTick_Config(SystemCoreClock / TIME_TICK_HZ);
+}
+
+void Time_Tick_ISR(void)
+{
+    g_tick_count++;
+}
+
+uint32_t Time_ms(void)
+{
+    return g_tick_count;
+}
+
+//  SysTick ֵҪͬһ: Ĺн˽жϾض.
+// жڼжϹ, , ʱõʱһ.
+// ߹ < SystemCoreClock / 1000, ԵԼ 2^26, ;
+// һۼƲ 1us, ĩβ ms*1000 + 1000, Ȼ
+uint32_t Time_us(void)
+{
+    uint32_t ms, val;
+
+    do {
+        ms  = g_tick_count;
+        val = SysTick->VAL;
+    } while (ms != g_tick_count);
+    return ms * 1000 + (((SysTick->LOAD - val) * us_per_cycle_q16) >> 16);
+}
+
+// ͬĶ,  HCLK :  * ÿ + ߹
+uint32_t Time_Cycles(void)
+{
+    uint32_t ms, val;
+
+    do {
+        ms  = g_tick_count;
+        val = SysTick->VAL;
+    } while (ms != g_tick_count);
+    return ms * (SysTick->LOAD + 1) + (SysTick->LOAD - val);
+}
+
+uint32_t Time_Deadline_ms(uint32_t ms)
+{
+    return g_tick_count + ms;
+}
+
+uint8_t Time_Expired_ms(uint32_t deadline)
+{
+    return (int32_t)(g_tick_count - deadline) >= 0;
+}
+
+uint32_t Time_Deadline_us(uint32_t us)
+{
+    return Time_us() + us;
+}
+
+uint8_t Time_Expired_us(uint32_t deadline)
+{
+    return (int32_t)(Time_us() - deadline) >= 0;
+}
+
+// һ, ʵʵȴ ms ~ ms+1  (ӲʱֻҪ "")
+void Time_Delay_ms(uint32_t ms)
+{
+    uint32_t deadline = Time_Deadline_ms(ms + 1);
+
+    while (!Time_Expired_ms(deadline))
+        __WFI();
+}
+
+void Time_Delay_us(uint32_t us)
+{
+    uint32_t deadline = Time_Deadline_us(us);
+
+    while (!Time_Expired_us(deadline))
+        ;
+}
@@ -0,0 +1,35 @@
+#ifndef __SYSTIME_H__
+#define __SYSTIME_H__
+
+#include <stdint.h>
+
+// ============================================================================
+//  SysTick ʱ׼: 1ms ĵĵ,  SysTick ǰֵõ΢.
+//  水 CPU ٶȹĿѭʱ (ƵŻȼ仯), ʱκαѡ¶׼ȷ.
+//
+//  ֹʱ (deadline)  32 λɼʾ, ȽʱȡзŲ, ԽҲȷ
+//  (Լ 24 졢΢Լ 35 ڵļ).
+//  ҳ Time_Deadline_ms / Time_Expired_ms ȴ;
+//  Time_Delay_ms / Time_Delay_us , ֻϵʼӲʱ.
+// ============================================================================
+
+#define TIME_TICK_HZ 1000   // SysTick Ƶ, һ 1ms
+
+extern volatile uint32_t g_tick_count;     // ϵĺ (SysTick ļ)
+
+void Time_Init(void);                      //  SysTick, SystemInit ֮ȵ
+void Time_Tick_ISR(void);                  //  SysTick_Handler 
+
+uint32_t Time_ms(void);
+uint32_t Time_us(void);
+uint32_t Time_Cycles(void);                // HCLK ʱ (Լ 85 ), ֻ
+
+uint32_t Time_Deadline_ms(uint32_t ms);    //  ms ֮Ľֹʱ
+uint8_t  Time_Expired_ms(uint32_t deadline);
+uint32_t Time_Deadline_us(uint32_t us);
+uint8_t  Time_Expired_us(uint32_t deadline);
+
+void Time_Delay_ms(uint32_t ms);           // ˯ (WFI) ȴ, жжʱ
+void Time_Delay_us(uint32_t us);           // æ
+
+#endif // __SYSTIME_H__
@@ -2,6 +2,7 @@
 #include "MCU_LCD.h"
 #include "fpga_registers.h"
 #include "event_handler.h"
+#include "prof.h"
 #include <stdio.h>
 #include <string.h> //  string.h  memset
 
@@ -16,70 +17,6 @@
 //  ļʵUIơصĺ
 // ============================================================================
 
-// --- Section 0:  ײͼ ---
-// Cohen-Sutherland ü㷨
-#define INSIDE 0 // 0000
-#define LEFT   1 // 0001
-#define RIGHT  2 // 0010
-#define BOTTOM 4 // 0100
-#define TOP    8 // 1000
-
-// һ
-static int compute_outcode(int x, int y, Box_XY clip_box) {
-    int code = INSIDE;
-    if (x < clip_box.X1) code |= LEFT;
-    else if (x > clip_box.X1 + clip_box.Width - 1) code |= RIGHT;
-    if (y < clip_box.Y1) code |= TOP;
-    else if (y > clip_box.Y1 + clip_box.Height - 1) code |= BOTTOM;
-    return code;
-}
-
-//  Cohen-Sutherland ü㷨Ļߺ
-static void lcd_draw_clipped_line(int x0, int y0, int x1, int y1, uint32_t color, Box_XY clip_box) {
-    int outcode0 = compute_outcode(x0, y0, clip_box);
-    int outcode1 = compute_outcode(x1, y1, clip_box);
-    int accept = 0;
-
-    while (1) {
-        if (!(outcode0 | outcode1)) { // 㶼ڲֱӽ
-            accept = 1;
-            break;
-        } else if (outcode0 & outcode1) { // 㶼ͬһⲿֱӾܾ
-            break;
-        } else {
-            // Ҫü
-            int x, y;
-            int outcode_out = outcode0 ? outcode0 : outcode1;
-            
-            if (outcode_out & TOP) {
-                x = x0 + (x1 - x0) * (clip_box.Y1 - y0) / (y1 - y0);
-                y = clip_box.Y1;
-            } else if (outcode_out & BOTTOM) {
-                x = x0 + (x1 - x0) * (clip_box.Y1 + clip_box.Height - 1 - y0) / (y1 - y0);
-                y = clip_box.Y1 + clip_box.Height - 1;
-            } else if (outcode_out & RIGHT) {
-                y = y0 + (y1 - y0) * (clip_box.X1 + clip_box.Width - 1 - x0) / (x1 - x0);
-                x = clip_box.X1 + clip_box.Width - 1;
-            } else { // LEFT
-                y = y0 + (y1 - y0) * (clip_box.X1 - x0) / (x1 - x0);
-                x = clip_box.X1;
-            }
-
-            if (outcode_out == outcode0) {
-                x0 = x; y0 = y; outcode0 = compute_outcode(x0, y0, clip_box);
-            } else {
-                x1 = x; y1 = y; outcode1 = compute_outcode(x1, y1, clip_box);
-            }
-        }
-    }
-    if (accept) {
-        lcd_draw_line(x0, y0, x1, y1, color);
-    }
-}
-
-
-
-
 // --- Section 1: ҳ漶ƺ ---
 void Display_Main_board(void)
 {
@@ -124,6 +61,11 @@ void Display_Analog_in(void)
 	Draw_Normal_Button(Analog_V_down);
 	Draw_Normal_Button(Analog_Freq_up);
 	Draw_Normal_Button(Analog_Freq_down);	
+	Draw_Normal_Button(Analog_Mode);
+	Draw_Normal_Button(Analog_Trig);
+	Draw_Normal_Button(Analog_FFT);
+	Draw_Normal_Button(Analog_CH);
+	Draw_Normal_Button(Analog_Deep);
 	Draw_Normal_Button(Analog_Start);
     Draw_Button_Effect(Analog_Stop);
 	Draw_Normal_Button(Analog_Reset);
@@ -311,9 +253,161 @@ void Draw_Waveform_Preview(uint32_t wave_type)
 
 // --- Section 3: ģغ ---
 // ... (˲޸) ...
-// ** ʾĺ **
+// --- ʾε¼ ---
+// ¼һ֡ÿһиǵΧ [top, bottom] (Ļ),
+// һֻ֡Щػָ/,  lcd_fill ػ.
+// top > bottom ʾûв.
+static int16_t scope_span_top[LCD_WIDTH];
+static int16_t scope_span_bottom[LCD_WIDTH];
+static uint8_t scope_span_valid = 0; // ¼ĻһʱΪ1
+// ڶ· (˫ͨ) һ֡ķΧ, Լ֡ռһ·ͬһķΧ
+static int16_t scope_span2_top[LCD_WIDTH];
+static int16_t scope_span2_bottom[LCD_WIDTH];
+static int16_t scope_next2_top[LCD_WIDTH];
+static int16_t scope_next2_bottom[LCD_WIDTH];
+static uint8_t scope_dual = 0;       // 1: һ·, ͬеĵڶ· scope_next2 ȡ
+
+#define SCOPE_TRACE_COLOR   BTN_GREEN_LIME    // һ· (ͨ) ɫ
+#define SCOPE_TRACE2_COLOR  BTN_YELLOW_GOLD   // ڶ·ɫ
+
+// λ ( Draw_Scope_Grid ), ʱػԭɫ
+static int16_t scope_grid_x[9];      // ֱߺ, 5Ϊ
+static int16_t scope_grid_y[7];      // ˮƽ, 4Ϊ
+
+static void Scope_Span_Clear(void)
+{
+    for (int x = 0; x < LCD_WIDTH; x++) {
+        scope_span_top[x] = 0x7FFF;
+        scope_span_bottom[x] = -1;
+        scope_span2_top[x] = 0x7FFF;
+        scope_span2_bottom[x] = -1;
+    }
+    scope_span_valid = 1;
+}
+
+// ´һڵд (еַ8 + еַ8 + 0x2C00)
+#define LCD_WINDOW_COST 17
+
+//  x е [top, bottom] д: [new_top, new_bottom] Ϊɫ, [top2, bottom2] Ϊڶ·ɫ
+// (·صһ·), ໹ԭΪ/.
+// ɫ Draw_Scope_Grid һ: ˮƽߺ, 봹ֱ߽洦ȡˮƽɫ.
+// rows_only Ϊ 1 ʱеĴѴ򿪹, ֻеַ.
+static void Scope_Column_Stream(int x, int top, int bottom, int new_top, int new_bottom, uint16_t color,
+                                int top2, int bottom2, int rows_only)
+{
+    uint16_t base = LCD_BLACK;
+    for (int i = 0; i < 9; i++) {
+        if (scope_grid_x[i] == x) {
+            base = (i == 4) ? UI_GRAY_MEDIUM : UI_GRAY_DARK;
+            break;
+        }
+    }
+
+    int gj = 0;                       // һˮƽߵ
+    while (gj < 7 && scope_grid_y[gj] < top) gj++;
+
+    if (rows_only) lcd_set_window_rows(top, bottom);
+    else           lcd_set_window(x, top, x, bottom);
+    for (int y = top; y <= bottom; y++) {
+        int on_grid = (gj < 7 && y == scope_grid_y[gj]);
+        if (y >= new_top && y <= new_bottom) {
+            mpu_write_data(color);
+        } else if (y >= top2 && y <= bottom2) {
+            mpu_write_data(SCOPE_TRACE2_COLOR);
+        } else if (on_grid) {
+            mpu_write_data((gj == 3) ? UI_GRAY_MEDIUM : UI_GRAY_DARK);
+        } else {
+            mpu_write_data(base);
+        }
+        if (on_grid) gj++;
+    }
+}
+
+// ˫ͨ: ·¾ɹĶηΧ, ܽĺϲ, ÿдһ;
+// ͬһֻһδ, ֮Ķֻеַ, д·Եʱͬ.
+static void Scope_Column_Write2(int x, int new_top, int new_bottom, uint16_t color,
+                                int old_top, int old_bottom, int top2, int bottom2)
+{
+    int seg_top[4], seg_bottom[4];
+    int n = 0, i, j;
+
+    if (old_top <= old_bottom)   { seg_top[n] = old_top;   seg_bottom[n] = old_bottom;   n++; }
+    if (new_top <= new_bottom)   { seg_top[n] = new_top;   seg_bottom[n] = new_bottom;   n++; }
+    if (scope_span2_top[x] <= scope_span2_bottom[x]) {
+        seg_top[n] = scope_span2_top[x]; seg_bottom[n] = scope_span2_bottom[x]; n++;
+    }
+    if (top2 <= bottom2)         { seg_top[n] = top2;      seg_bottom[n] = bottom2;      n++; }
+
+    scope_span2_top[x] = top2;
+    scope_span2_bottom[x] = bottom2;
+
+    for (i = 1; i < n; i++) {                 //  4 , 
+        int t = seg_top[i], b = seg_bottom[i];
+        for (j = i; j > 0 && seg_top[j - 1] > t; j--) {
+            seg_top[j] = seg_top[j - 1];
+            seg_bottom[j] = seg_bottom[j - 1];
+        }
+        seg_top[j] = t;
+        seg_bottom[j] = b;
+    }
+
+    int opened = 0;
+    for (i = 0; i < n; ) {
+        int t = seg_top[i], b = seg_bottom[i];
+        for (i++; i < n && seg_top[i] - b <= LCD_WINDOW_COST; i++)
+            if (seg_bottom[i] > b) b = seg_bottom[i];
+        Scope_Column_Stream(x, t, b, new_top, new_bottom, color, top2, bottom2, opened);
+        opened = 1;
+    }
+}
+
+// һ: һ֡Ĳβ֡Ĳ.
+// [new_top, new_bottom] Ϊ֡ڸеķΧ (Ѳü), new_top > new_bottom ʾû.
+// ¾ɷΧཻܽʱϲΪһ, ֱ򿪴, д֮.
+// еڶ· (һ֡֡Ҫ) ʱ Scope_Column_Write2 һ.
+static void Scope_Column_Write(int x, int new_top, int new_bottom, uint16_t color)
+{
+    int old_top = scope_span_top[x];
+    int old_bottom = scope_span_bottom[x];
+    int top2 = 0x7FFF, bottom2 = -1;
+
+    scope_span_top[x] = new_top;
+    scope_span_bottom[x] = new_bottom;
+
+    if (scope_dual) {
+        top2 = scope_next2_top[x];
+        bottom2 = scope_next2_bottom[x];
+    }
+    if (top2 <= bottom2 || scope_span2_top[x] <= scope_span2_bottom[x]) {
+        Scope_Column_Write2(x, new_top, new_bottom, color, old_top, old_bottom, top2, bottom2);
+        return;
+    }
+
+    if (old_top > old_bottom) {
+        if (new_top <= new_bottom)
+            lcd_draw_vline(x, new_top, new_bottom - new_top + 1, color);
+        return;
+    }
+    if (new_top > new_bottom) {
+        Scope_Column_Stream(x, old_top, old_bottom, new_top, new_bottom, color, 0x7FFF, -1, 0);
+        return;
+    }
+    if (new_top - old_bottom > LCD_WINDOW_COST || old_top - new_bottom > LCD_WINDOW_COST) {
+        Scope_Column_Stream(x, old_top, old_bottom, new_top, new_bottom, color, 0x7FFF, -1, 0);
+        lcd_set_window_rows(new_top, new_bottom);   // ͬһ, ֻеַ
+        for (int y = new_top; y <= new_bottom; y++)
+            mpu_write_data(color);
+        return;
+    }
+    Scope_Column_Stream(x, (new_top < old_top) ? new_top : old_top,
+                        (new_bottom > old_bottom) ? new_bottom : old_bottom,
+                        new_top, new_bottom, color, 0x7FFF, -1, 0);
+}
+
+// ** ʾĺ (ػ, ڽҳҪʱ) **
 void Draw_Scope_Grid(Box_XY board)
 {
+    PROF_START(PROF_SCOPE_GRID);
     // 1. ɫ
     lcd_fill(board.X1, board.Y1, board.X1 + board.Width - 1, board.Y1 + board.Height - 1, LCD_BLACK);
 
@@ -332,6 +426,7 @@ void Draw_Scope_Grid(Box_XY board)
         // ʹýĻɫ
         uint32_t color = (i == 5) ? UI_GRAY_MEDIUM : UI_GRAY_DARK;
         lcd_draw_line(x, y_start, x, y_end, color);
+        scope_grid_x[i - 1] = x;
     }
     // ˮƽ
     for (int i = 1; i < 8; i++) {
@@ -339,37 +434,375 @@ void Draw_Scope_Grid(Box_XY board)
         // ʹýĻɫ
         uint32_t color = (i == 4) ? UI_GRAY_MEDIUM : UI_GRAY_DARK;
         lcd_draw_line(x_start, y, x_end, y, color);
+        scope_grid_y[i - 1] = y;
     }
+
+    // Ǹɾ, ֮ǰ¼Ĳ
+    Scope_Span_Clear();
+    PROF_STOP(PROF_SCOPE_GRID);
 }
 
 
-// ** д: Draw_Scope_Waveform ʹ߶βü **
-void Draw_Scope_Waveform(uint8_t* buffer, int points, Box_XY board, uint16_t volts_per_div_mv)
+// --- ұ ---
+// Cortex-M1 ûӲָ, 껻ĳȫŵʱ,
+// ÿ֡ĻѭֻͼӼ.
+static int16_t  scope_y_lut[257];              // ADC -> ĻY (δü), [256] ΪƵ,  Q8.8 ֵ
+static uint16_t scope_y_lut_mv = 0;            // ʱ V/div, 0 ʾЧ
+static Box_XY   scope_y_lut_board;
+
+static int Box_Equal(Box_XY a, Box_XY b)
 {
-    if (points <= 1) return;
+    return a.X1 == b.X1 && a.Y1 == b.Y1 && a.Width == b.Width && a.Height == b.Height;
+}
 
+// V/div 򻭰仯ʱؽ ADC -> Y  (㹫ʽԭһ)
+static void Scope_Build_Y_LUT(Box_XY board, uint16_t volts_per_div_mv)
+{
     const int32_t VOLTS_PER_SCREEN_MV = (int32_t)volts_per_div_mv * 8;
     const int32_t y_center = board.Y1 + board.Height / 2;
     const int32_t y_half_height = board.Height / 2;
 
-    for (int i = 0; i < (points - 1); i++)
+    for (int code = 0; code < 256; code++) {
+        int32_t voltage_mv = ((code - 128) * ADC_FSR_MV) / 128;
+        scope_y_lut[code] = (int16_t)(y_center - (voltage_mv * y_half_height) / (VOLTS_PER_SCREEN_MV / 2));
+    }
+    scope_y_lut[256] = (int16_t)(2 * scope_y_lut[255] - scope_y_lut[254]);
+    scope_y_lut_mv = volts_per_div_mv;
+    scope_y_lut_board = board;
+}
+
+// ĻY -> ADC: ڲұӽ (ڵôƽ)
+uint8_t Scope_Code_At_Y(Box_XY board, uint16_t volts_per_div_mv, int y)
+{
+    int best = 128, best_err = 0x7FFF;
+
+    if (scope_y_lut_mv != volts_per_div_mv || !Box_Equal(scope_y_lut_board, board))
+        Scope_Build_Y_LUT(board, volts_per_div_mv);
+
+    for (int code = 0; code < 256; code++) {
+        int err = scope_y_lut[code] - y;
+        if (err < 0) err = -err;
+        if (err < best_err) { best_err = err; best = code; }
+    }
+    return (uint8_t)best;
+}
+
+
+// --- лƲ ---
+// ΰ: ÿֻһδ, дһδСֵֵĴֱγ.
+// ͬһʱֻϲΧ (ֵᶪʧ), е߶ Bresenham
+// ɸеγ, ˵СʱλߵĽһ.
+// LCD дֻ뻭й, ޹.
+typedef struct {
+    int x;              // ۻ, -1 ʾ
+    int lo, hi;         // ѸǵΧ (δü)
+    int next_restore;   // һδ (/ػ) 
+    int top, bottom;    // Χ
+    uint16_t color;
+    uint8_t collect;    // 1: ڶ·, ֻѸзΧ scope_next2, д
+} Scope_Column_Acc;
+
+// һеķΧ: д,  (ڶ·) ȵһ·ͬʱһд
+static void Scope_Acc_Emit(Scope_Column_Acc* acc, int x, int lo, int hi)
+{
+    if (acc->collect) {
+        scope_next2_top[x] = lo;
+        scope_next2_bottom[x] = hi;
+    } else {
+        Scope_Column_Write(x, lo, hi, acc->color);
+    }
+}
+
+// ۻһ, ౾֡ûиǵ
+static void Scope_Acc_Flush(Scope_Column_Acc* acc)
+{
+    while (acc->next_restore < acc->x) {
+        Scope_Acc_Emit(acc, acc->next_restore, 0x7FFF, -1);
+        acc->next_restore++;
+    }
+
+    int lo = acc->lo < acc->top ? acc->top : acc->lo;
+    int hi = acc->hi > acc->bottom ? acc->bottom : acc->hi;
+    Scope_Acc_Emit(acc, acc->x, lo, hi);   // lo > hi ʱֻ
+    acc->next_restore = acc->x + 1;
+}
+
+// ѵ x еһ [y0, y1] ۻ (x )
+static void Scope_Acc_Add(Scope_Column_Acc* acc, int x, int y0, int y1)
+{
+    int t;
+    if (y0 > y1) { t = y0; y0 = y1; y1 = t; }
+
+    if (x != acc->x) {
+        if (acc->x >= 0) Scope_Acc_Flush(acc);
+        acc->x = x;
+        acc->lo = y0;
+        acc->hi = y1;
+    } else {
+        if (y0 < acc->lo) acc->lo = y0;
+        if (y1 > acc->hi) acc->hi = y1;
+    }
+}
+
+// ߶ (xa < xb):  Bresenham ɸеγ
+static void Scope_Acc_Segment(Scope_Column_Acc* acc, int xa, int ya, int xb, int yb)
+{
+    int delta_x = xb - xa;
+    int delta_y = yb - ya;
+    int incy = 1;
+    int err, run_start;
+
+    if (delta_y < 0) { incy = -1; delta_y = -delta_y; }
+
+    if (delta_x == 1 && delta_y > 1) {
+        //  (ӽʱ): ǰһ xa ,  xb ,  Bresenham ͬ
+        int mid = ya + incy * (delta_y >> 1);
+        Scope_Acc_Add(acc, xa, ya, mid);
+        Scope_Acc_Add(acc, xb, mid + incy, yb);
+    } else if (delta_x >= delta_y) {
+        // XΪ: ÿһ
+        err = delta_x >> 1;
+        for (int x = xa; x <= xb; x++) {
+            Scope_Acc_Add(acc, x, ya, ya);
+            err -= delta_y;
+            if (err < 0) { err += delta_x; ya += incy; }
+        }
+    } else {
+        // YΪ: ÿXʱǰеγ
+        err = delta_y >> 1;
+        run_start = ya;
+        while (ya != yb) {
+            err -= delta_x;
+            if (err < 0) {
+                Scope_Acc_Add(acc, xa, run_start, ya);
+                err += delta_y;
+                xa++;
+                run_start = ya + incy;
+            }
+            ya += incy;
+        }
+        Scope_Acc_Add(acc, xa, run_start, ya);
+    }
+}
+
+// һ֡ʼ: Ҫʱػ/ؽұ, ʼۻ (volts_per_div_mv Ϊ 0 ʾòұ)
+static void Scope_Frame_Begin(Scope_Column_Acc* acc, Box_XY board, uint16_t volts_per_div_mv)
+{
+    if (!scope_span_valid) {
+        Draw_Scope_Grid(board);
+    }
+    if (volts_per_div_mv != 0 &&
+        (scope_y_lut_mv != volts_per_div_mv || !Box_Equal(scope_y_lut_board, board)))
+        Scope_Build_Y_LUT(board, volts_per_div_mv);
+
+    acc->x = -1;
+    acc->next_restore = board.X1;
+    acc->top = board.Y1;
+    acc->bottom = board.Y1 + board.Height - 1;
+    acc->color = SCOPE_TRACE_COLOR;
+    acc->collect = 0;
+}
+
+// һ֡: һ, Ҳʣһ֡Ĳ
+static void Scope_Frame_End(Scope_Column_Acc* acc, Box_XY board)
+{
+    Scope_Acc_Flush(acc);
+
+    acc->x = board.X1 + board.Width;
+    while (acc->next_restore < acc->x) {
+        Scope_Acc_Emit(acc, acc->next_restore, 0x7FFF, -1);
+        acc->next_restore++;
+    }
+}
+
+// ** Draw_Scope_Waveform: һ֡βл² **
+// ǰϱ Draw_Scope_Grid  (һ֡Ĳ).
+// 㵽еӳۼ (ȼ i*(Width-1)/(points-1) ȡ),
+// , ѭûг. points Զڻ ( 4K~64K 洢).
+// һ· 8 λ ( stride ֽ) ۻ
+static void Scope_Trace_u8(Scope_Column_Acc* acc, const uint8_t* buffer, int stride, int points, Box_XY board)
+{
+    const int32_t den = points - 1;          // ӳ: x = X1 + i*num/den
+    const int32_t num = board.Width - 1;
+    int32_t frac = 0;
+    int x = board.X1;
+    int y = scope_y_lut[buffer[0]];
+
+    Scope_Acc_Add(acc, x, y, y);
+    for (int i = 1; i < points; i++)
     {
-        // --- ߶ (Point A) ---
-        // ʹ int ƥü
-        int pA_sx = board.X1 + (long)(i * (board.Width - 1)) / (points - 1);
-        int32_t voltage_mv_A = (((int32_t)buffer[i] - 128) * ADC_FSR_MV) / 128;
-        // Y꣬ʱܳĻΧ
-        int pA_sy = y_center - (long)(voltage_mv_A * y_half_height) / (VOLTS_PER_SCREEN_MV / 2);
-
-        // --- ߶յ (Point B) ---
-        int pB_sx = board.X1 + (long)((i + 1) * (board.Width - 1)) / (points - 1);
-        int32_t voltage_mv_B = (((int32_t)buffer[i+1] - 128) * ADC_FSR_MV) / 128;
-        int pB_sy = y_center - (long)(voltage_mv_B * y_half_height) / (VOLTS_PER_SCREEN_MV / 2);
-
-        // --- ** : ʹôüĻߺ ** ---
-        // Ƴɵı߽飬ԭʼͲü򽻸º
-        lcd_draw_clipped_line(pA_sx, pA_sy, pB_sx, pB_sy, BTN_GREEN_LIME, board);
+        int nx = x;
+        int ny = scope_y_lut[buffer[i * stride]];
+
+        frac += num;
+        while (frac >= den) { frac -= den; nx++; }
+
+        if (nx == x) {
+            Scope_Acc_Add(acc, x, y, ny);    // ͬһ: ϲ min/max
+        } else {
+            Scope_Acc_Segment(acc, x, y, nx, ny);
+        }
+        x = nx;
+        y = ny;
+    }
+}
+
+void Draw_Scope_Waveform(uint8_t* buffer, int points, Box_XY board, uint16_t volts_per_div_mv)
+{
+    if (points <= 1) return;
+
+    PROF_START(PROF_SCOPE_WAVEFORM);
+    Scope_Column_Acc acc;
+    Scope_Frame_Begin(&acc, board, volts_per_div_mv);
+    Scope_Trace_u8(&acc, buffer, 1, points, board);
+    Scope_Frame_End(&acc, board);
+    PROF_STOP(PROF_SCOPE_WAVEFORM);
+}
+
+// ** Draw_Scope_Dual: ˫ͨʾ **
+// pairs Ϊ FPGA ˫ͨʽ {CH1, CH2} ֽڶ, slots Ϊ.
+// Ȱѵڶ·ĸзΧռ scope_next2 (д), ٰһ·ʱͬе
+// ڶ·һд: ÿֻһδ, ·صһ·.
+void Draw_Scope_Dual(uint8_t* pairs, int slots, Box_XY board, uint16_t volts_per_div_mv)
+{
+    if (slots <= 1) return;
+
+    Scope_Column_Acc acc;
+    Scope_Frame_Begin(&acc, board, volts_per_div_mv);
+    acc.collect = 1;
+    Scope_Trace_u8(&acc, pairs + 1, 2, slots, board);
+    Scope_Frame_End(&acc, board);
+
+    Scope_Frame_Begin(&acc, board, volts_per_div_mv);
+    scope_dual = 1;
+    Scope_Trace_u8(&acc, pairs, 2, slots, board);
+    Scope_Frame_End(&acc, board);
+    scope_dual = 0;
+}
+
+// Q8.8  -> ĻY: ֲ, С֮Բֵ
+static int Scope_Y_Q8(uint16_t v)
+{
+    int code = v >> 8;
+    int y0 = scope_y_lut[code];
+    return y0 + (((scope_y_lut[code + 1] - y0) * (int)(v & 0xFF)) >> 8);
+}
+
+// ** Draw_Scope_Waveform16: ƽȡ (Q8.8, 16 λ) ݵĲʾ **
+//  Draw_Scope_Waveform ͬӳͻ, ֻ갴 Q8.8 ֵ,
+// ֵСֿ ADC ֮.
+void Draw_Scope_Waveform16(uint16_t* buffer, int points, Box_XY board, uint16_t volts_per_div_mv)
+{
+    if (points <= 1) return;
+
+    Scope_Column_Acc acc;
+    Scope_Frame_Begin(&acc, board, volts_per_div_mv);
+
+    const int32_t den = points - 1;
+    const int32_t num = board.Width - 1;
+    int32_t frac = 0;
+    int x = board.X1;
+    int y = Scope_Y_Q8(buffer[0]);
+
+    Scope_Acc_Add(&acc, x, y, y);
+    for (int i = 1; i < points; i++)
+    {
+        int nx = x;
+        int ny = Scope_Y_Q8(buffer[i]);
+
+        frac += num;
+        while (frac >= den) { frac -= den; nx++; }
+
+        if (nx == x) {
+            Scope_Acc_Add(&acc, x, y, ny);
+        } else {
+            Scope_Acc_Segment(&acc, x, y, nx, ny);
+        }
+        x = nx;
+        y = ny;
+    }
+    Scope_Frame_End(&acc, board);
+}
+
+// ** Draw_Scope_Envelope: ֵȡݵİʾ **
+// pairs Ϊ FPGA ֵʽ {min, max} ֽڶ, slots Ϊ.
+// ÿл [min, max] , ڴڵе֮䰴߶,
+// ʹʱȻ.
+void Draw_Scope_Envelope(uint8_t* pairs, int slots, Box_XY board, uint16_t volts_per_div_mv)
+{
+    if (slots <= 1) return;
+
+    Scope_Column_Acc acc;
+    Scope_Frame_Begin(&acc, board, volts_per_div_mv);
+
+    const int32_t den = slots - 1;           // ӳ Draw_Scope_Waveform ͬ
+    const int32_t num = board.Width - 1;
+    int32_t frac = 0;
+    int x = board.X1;
+    int y_lo = scope_y_lut[pairs[0]];         // min Ӧ Y (ĻY, ·)
+    int y_hi = scope_y_lut[pairs[1]];         // max Ӧ Y
+    int y_mid = (y_lo + y_hi) >> 1;
+
+    Scope_Acc_Add(&acc, x, y_lo, y_hi);
+    for (int i = 1; i < slots; i++)
+    {
+        int nx = x;
+        int ny_lo = scope_y_lut[pairs[2 * i]];
+        int ny_hi = scope_y_lut[pairs[2 * i + 1]];
+        int ny_mid = (ny_lo + ny_hi) >> 1;
+
+        frac += num;
+        while (frac >= den) { frac -= den; nx++; }
+
+        if (nx != x) {
+            Scope_Acc_Segment(&acc, x, y_mid, nx, ny_mid);
+        }
+        Scope_Acc_Add(&acc, nx, ny_lo, ny_hi);
+        x = nx;
+        y_mid = ny_mid;
+    }
+    Scope_Frame_End(&acc, board);
+}
+
+// ** Draw_Scope_Spectrum: Ƶʾ **
+// db Ϊ bin ҵķ (0.1dB), ÿ bin һӷȵײ.
+//  0dB ڶ, ÿ 10dB, 8  -80dB;  bin 0 (ֱ) , ο˹.
+// bin ʱһ bin ռ, ʱͬһȡߵ bin (ۻϲΧ).
+// 벨ιۻ, лͼʱֻͬһ֡.
+#define SCOPE_SPECTRUM_DB_RANGE (800)   //  80dB
+void Draw_Scope_Spectrum(const int16_t* db, int bins, Box_XY board)
+{
+    if (bins <= 0) return;
+
+    Scope_Column_Acc acc;
+    Scope_Frame_Begin(&acc, board, 0);
+
+    const int32_t y_scale = ((int32_t)board.Height << 16) / SCOPE_SPECTRUM_DB_RANGE; // ÿ֡һγ
+    const int32_t den = bins;                 // ӳ: bin k ռ [X1 + k*W/bins, X1 + (k+1)*W/bins)
+    const int32_t num = board.Width;
+    const int bottom = board.Y1 + board.Height - 1;
+    int32_t frac = 0;
+    int x = board.X1;
+
+    for (int k = 0; k < bins; k++)
+    {
+        int32_t d = -db[k];
+        if (d < 0) d = 0;
+        if (d > SCOPE_SPECTRUM_DB_RANGE) d = SCOPE_SPECTRUM_DB_RANGE;
+        int y = board.Y1 + ((d * y_scale) >> 16);
+
+        int nx = x;
+        frac += num;
+        while (frac >= den) { frac -= den; nx++; }
+
+        if (nx == x) {
+            Scope_Acc_Add(&acc, x, y, bottom);
+        } else {
+            for (; x < nx; x++)
+                Scope_Acc_Add(&acc, x, y, bottom);
+        }
     }
+    Scope_Frame_End(&acc, board);
 }
 
 
@@ -387,9 +820,9 @@ void Update_Analog_Display(uint16_t v_div_mv, uint32_t time_div_us)
     
     // ---  ޸ģ Time/Div ʾ ( ms λ)  ---
     if (time_div_us >= 1000) { // ڵ 1ms (1000us)
-        sprintf(display_str_buffer, " T/Div: %lums", time_div_us / 1000);
+        sprintf(display_str_buffer, " T/Div: %lums", (unsigned long)(time_div_us / 1000));
     } else {
-        sprintf(display_str_buffer, " T/Div: %luus", time_div_us);
+        sprintf(display_str_buffer, " T/Div: %luus", (unsigned long)time_div_us);
     }
     Draw_Text_Boundary(Analog_Freq_Text, display_str_buffer);
     
@@ -398,37 +831,152 @@ void Update_Analog_Display(uint16_t v_div_mv, uint32_t time_div_us)
     Draw_Text_Boundary(Analog_Sample_Text, display_str_buffer);
 }
 
+//  -> "x.xx"  ()
+static void Format_Volt(char* s, int32_t mv)
+{
+    const char* sign = (mv < 0) ? "-" : "";
+    if (mv < 0) mv = -mv;
+    mv += 5;                                  // 뵽 10mV
+    sprintf(s, "%s%ld.%02ld", sign, (long)(mv / 1000), (long)((mv % 1000) / 10));
+}
+
+//  -> λʱ
+static void Format_Time_ns(char* s, uint32_t ns)
+{
+    if (ns >= 1000000) {
+        sprintf(s, "%lu.%02lums", (unsigned long)(ns / 1000000), (unsigned long)((ns % 1000000) / 10000));
+    } else if (ns >= 1000) {
+        sprintf(s, "%lu.%01luus", (unsigned long)(ns / 1000), (unsigned long)((ns % 1000) / 100));
+    } else {
+        sprintf(s, "%luns", (unsigned long)ns);
+    }
+}
+
+// 0.01Hz ΪλƵ -> λƵ
+static void Format_Freq_cHz(char* s, uint32_t f_chz)
+{
+    if (f_chz >= 100000000UL) {
+        sprintf(s, "%lu.%03luMHz", f_chz / 100000000UL, (f_chz % 100000000UL) / 100000UL);
+    } else if (f_chz >= 100000UL) {
+        sprintf(s, "%lu.%03lukHz", f_chz / 100000UL, (f_chz % 100000UL) / 100UL);
+    } else {
+        sprintf(s, "%lu.%02luHz", (unsigned long)(f_chz / 100), (unsigned long)(f_chz % 100));
+    }
+}
+
+// ** Update_Analog_Measure: ʾ **
+// һ V/Div + ֵ, ڶ T/Div + Ƶ, а page ʾ
+// /Сֵƽ/Чֵ (page >= ANALOG_MEAS_PAGES ʱ, Ƶ׷ֵ).
+// slot_ns Ϊʱ. ֻڽˢ, ĳÿ֡·.
+void Update_Analog_Measure(const Scope_Meas_Result* r, uint16_t v_div_mv, uint32_t time_div_us,
+                           uint32_t slot_ns, uint8_t page)
+{
+    char a[16], b[16];
+
+    // --- V/Div + Vpp ---
+    Format_Volt(a, r->vmax_mv - r->vmin_mv);
+    if (v_div_mv >= 1000) {
+        sprintf(display_str_buffer, " %uV Vpp %sV", v_div_mv / 1000, a);
+    } else {
+        sprintf(display_str_buffer, " %umV Vpp %sV", v_div_mv, a);
+    }
+    Draw_Text_Boundary(Analog_Volt_Text, display_str_buffer);
+
+    // --- T/Div + Ƶ: f = cycles / (span * slot_ns),  0.01Hz Ϊλ ---
+    if (time_div_us >= 1000) {
+        sprintf(a, "%lums", (unsigned long)(time_div_us / 1000));
+    } else {
+        sprintf(a, "%luus", (unsigned long)time_div_us);
+    }
+    if (r->cycles > 0 && r->span > 0) {
+        Format_Freq_cHz(b, (uint32_t)((100000000000ULL * (uint32_t)r->cycles) /
+                                      ((uint64_t)(uint32_t)r->span * slot_ns)));
+    } else {
+        sprintf(b, "---");
+    }
+    sprintf(display_str_buffer, " %s F %s", a, b);
+    Draw_Text_Boundary(Analog_Freq_Text, display_str_buffer);
+
+    // --- ʾĵ ---
+    if (page >= ANALOG_MEAS_PAGES) {
+        return;
+    } else if (page == 0) {
+        Format_Volt(a, r->vmax_mv);
+        Format_Volt(b, r->vmin_mv);
+        sprintf(display_str_buffer, " Hi %s Lo %s", a, b);
+    } else if (page == 1) {
+        Format_Volt(a, r->vavg_mv);
+        Format_Volt(b, r->vrms_mv);
+        sprintf(display_str_buffer, " Av %s Rm %s", a, b);
+    } else if (r->cycles > 0 && r->span > 0) {
+        Format_Time_ns(a, (uint32_t)r->span * slot_ns / (uint32_t)r->cycles);
+        sprintf(display_str_buffer, " T %s", a);
+    } else {
+        sprintf(display_str_buffer, " T ---");
+    }
+    Draw_Text_Boundary(Analog_Sample_Text, display_str_buffer);
+}
+
+// ** Update_Analog_Peak: Ƶͼĵ, ʾ׷Ƶʺͷ **
+// ֵƵ = peak_bin / (points * slot_ns),  0.01Hz Ϊλ; peak_db λ 0.1dB, ʾȡ 1dB
+void Update_Analog_Peak(int peak_bin, int16_t peak_db, int points, uint32_t slot_ns)
+{
+    char a[16];
+
+    if (peak_bin > 0) {
+        int db = (((peak_db < 0) ? -peak_db : peak_db) + 5) / 10;
+        Format_Freq_cHz(a, (uint32_t)((100000000000ULL * (uint32_t)peak_bin) /
+                                      ((uint64_t)(uint32_t)points * slot_ns)));
+        sprintf(display_str_buffer, " Pk %s %s%ddB", a, (peak_db < 0 && db > 0) ? "-" : "", db);
+    } else {
+        sprintf(display_str_buffer, " Pk ---");
+    }
+    Draw_Text_Boundary(Analog_Sample_Text, display_str_buffer);
+}
+
+// ** Update_Analog_Deep: 洢ͼĵڶ, ǰŵ T/Div¼Ⱥͼڼ¼еλ **
+void Update_Analog_Deep(uint32_t time_div_ns, uint32_t record_len, uint8_t pos_percent)
+{
+    char a[16];
+
+    Format_Time_ns(a, time_div_ns);
+    sprintf(display_str_buffer, " T/Div: %s", a);
+    Draw_Text_Boundary(Analog_Freq_Text, display_str_buffer);
+    sprintf(display_str_buffer, " Deep %luK @%u%%", (unsigned long)(record_len >> 10), pos_percent);
+    Draw_Text_Boundary(Analog_Sample_Text, display_str_buffer);
+}
+
 // --- Section 4: غ ---
 void Update_Digital_Display(uint32_t frequency, uint32_t duty, uint32_t t_high_ns, uint32_t t_low_ns)
 {
     // ... (˲޸) ...
     // Ƶ
     if (frequency > 1000000) { // MHz
-        sprintf(display_str_buffer, "Freq: %lu.%03lu MHz", frequency / 1000000, (frequency % 1000000) / 1000);
+        sprintf(display_str_buffer, "Freq: %lu.%03lu MHz", (unsigned long)(frequency / 1000000), (unsigned long)((frequency % 1000000) / 1000));
     } else if (frequency > 1000) { // kHz
-        sprintf(display_str_buffer, "Freq: %lu.%03lu kHz", frequency / 1000, frequency % 1000);
+        sprintf(display_str_buffer, "Freq: %lu.%03lu kHz", (unsigned long)(frequency / 1000), (unsigned long)(frequency % 1000));
     } else { // Hz
-        sprintf(display_str_buffer, "Freq: %lu Hz", frequency);
+        sprintf(display_str_buffer, "Freq: %lu Hz", (unsigned long)frequency);
     }
     Draw_Text_Boundary(Digital_Freq_Text, display_str_buffer);
     
     // ռձ
-    sprintf(display_str_buffer, "Duty: %lu %%", duty);
+    sprintf(display_str_buffer, "Duty: %lu %%", (unsigned long)duty);
     Draw_Text_Boundary(Digital_Duty_Text, display_str_buffer);
 
     // ¸ߵƽʱ
     if (t_high_ns > 1000) { // us
-        sprintf(display_str_buffer, "T_high: %lu.%03lu us", t_high_ns / 1000, t_high_ns % 1000);
+        sprintf(display_str_buffer, "T_high: %lu.%03lu us", (unsigned long)(t_high_ns / 1000), (unsigned long)(t_high_ns % 1000));
     } else { // ns
-        sprintf(display_str_buffer, "T_high: %lu ns", t_high_ns);
+        sprintf(display_str_buffer, "T_high: %lu ns", (unsigned long)t_high_ns);
     }
     Draw_Text_Boundary(Digital_tHigh_Text, display_str_buffer);
 
     // µ͵ƽʱ
     if (t_low_ns > 1000) { // us
-        sprintf(display_str_buffer, "T_low: %lu.%03lu us", t_low_ns / 1000, t_low_ns % 1000);
+        sprintf(display_str_buffer, "T_low: %lu.%03lu us", (unsigned long)(t_low_ns / 1000), (unsigned long)(t_low_ns % 1000));
     } else { // ns
-        sprintf(display_str_buffer, "T_low: %lu ns", t_low_ns);
+        sprintf(display_str_buffer, "T_low: %lu ns", (unsigned long)t_low_ns);
     }
     Draw_Text_Boundary(Digital_tLow_Text, display_str_buffer);
 }
@@ -491,10 +1039,10 @@ void Display_Analyze_Results(SignalAnalysisResult_t* result)
     sprintf(display_str_buffer, "Encoding: %s", result->encoding_type);
     lcd_show_string(x, y, w, h+2, display_str_buffer, h);
     y += h + 5;
-    sprintf(display_str_buffer, "Baud Rate: %lu bps", result->baud_rate_est);
+    sprintf(display_str_buffer, "Baud Rate: %lu bps", (unsigned long)result->baud_rate_est);
     lcd_show_string(x, y, w, h+2, display_str_buffer, h);
     y += h + 5;
-    sprintf(display_str_buffer, "1-Bit Width: %lu samples", result->bit_width);
+    sprintf(display_str_buffer, "1-Bit Width: %lu samples", (unsigned long)result->bit_width);
     lcd_show_string(x, y, w, h+2, display_str_buffer, h);
     y += h + 10; 
 
@@ -894,31 +1442,29 @@ void Analyze_and_Display_Signal(
     }
     
     // --- Pass 2: ѡıн ---
-    int success = 0;
     switch (encoding)
     {
         case ENCODE_NRZ_L:
-            success = decode_nrz_l(&result, buffer, points, first_edge_index, result.bit_width);
+            decode_nrz_l(&result, buffer, points, first_edge_index, result.bit_width);
             break;
         case ENCODE_RZ:
-            success = decode_rz(&result, buffer, points, first_edge_index, result.bit_width);
+            decode_rz(&result, buffer, points, first_edge_index, result.bit_width);
             break;
         case ENCODE_NRZ_I:
-            success = decode_nrz_i(&result, buffer, points, first_edge_index, result.bit_width);
+            decode_nrz_i(&result, buffer, points, first_edge_index, result.bit_width);
             break;
         case ENCODE_MANCHESTER:
-            success = decode_manchester(&result, buffer, points, first_edge_index, result.bit_width);
+            decode_manchester(&result, buffer, points, first_edge_index, result.bit_width);
             break;
         case ENCODE_DIFF_MANCHESTER:
-             success = decode_diff_manchester(&result, buffer, points, first_edge_index, result.bit_width);
+             decode_diff_manchester(&result, buffer, points, first_edge_index, result.bit_width);
             break;
         case ENCODE_UART: // ** <---  **
              // UART Լͬ߼Ҫ first_edge_index
-             success = decode_uart(&result, buffer, points, result.bit_width);
+             decode_uart(&result, buffer, points, result.bit_width);
              break;
         default:
             strcpy(result.encoding_type, "Not Implemented");
-            success = 0;
     }
     
     Display_Analyze_Results(&result);
@@ -1004,21 +1550,3 @@ void Display_Loading_Screen(const char* module_name)
     
     lcd_show_string(x, y, w, h, buffer, s);
 }
-
-//  ʱ 
-// (һԵġʱUI)
-// (ע⣺GOWIN_M1 CPUʱƵ 50MHz)
-#define CPU_CYCLES_PER_MS (50000) //  50MHz, ÿ 50000 
-void mcu_sw_delay_ms(volatile uint32_t ms)
-{
-    volatile uint32_t i, j;
-    // (ѭҪʵCPUƵʺŻȼдԵ)
-    // (ǼѭԼ 10-20 )
-    const uint32_t loops_per_ms = CPU_CYCLES_PER_MS / 15; 
-
-    for (i = 0; i < ms; i++) {
-        for (j = 0; j < loops_per_ms; j++) {
-            __asm volatile("nop");
-        }
-    }
-}
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "PageDesign.h"
 #include <stdint.h>
 #include "digital_input_features.h" 
+#include "scope_measure.h"
 
 
 // ============================================================================
@@ -18,15 +19,24 @@ void Display_USB_CDC(void);
 void Update_Waveform_Display(uint32_t wave_type, uint32_t freq_code, uint32_t amp_code, uint32_t duty_code);
 void Draw_Waveform_Preview(uint32_t wave_type);
 void Update_Analog_Display(uint16_t v_div_mv, uint32_t time_div_us);
+void Update_Analog_Measure(const Scope_Meas_Result* r, uint16_t v_div_mv, uint32_t time_div_us,
+                           uint32_t slot_ns, uint8_t page);
+#define ANALOG_MEAS_PAGES 3
+void Update_Analog_Peak(int peak_bin, int16_t peak_db, int points, uint32_t slot_ns);
+void Update_Analog_Deep(uint32_t time_div_ns, uint32_t record_len, uint8_t pos_percent);
 void Draw_Scope_Grid(Box_XY board);
 void Draw_Scope_Waveform(uint8_t* buffer, int points, Box_XY board, uint16_t volts_per_div_mv);
+void Draw_Scope_Envelope(uint8_t* pairs, int slots, Box_XY board, uint16_t volts_per_div_mv);
+void Draw_Scope_Dual(uint8_t* pairs, int slots, Box_XY board, uint16_t volts_per_div_mv);
+void Draw_Scope_Waveform16(uint16_t* buffer, int points, Box_XY board, uint16_t volts_per_div_mv);
+void Draw_Scope_Spectrum(const int16_t* db, int bins, Box_XY board);
+uint8_t Scope_Code_At_Y(Box_XY board, uint16_t volts_per_div_mv, int y);
 void Update_Digital_Display(uint32_t frequency, uint32_t duty, uint32_t t_high, uint32_t t_low);
 void Display_Digital_in_MeasureMode(void);
 void Display_Digital_in_AnalyzeMode(void);
 
 
 void Display_Loading_Screen(const char* module_name);
-void mcu_sw_delay_ms(volatile uint32_t ms);
 // ============================================================================
 // --- Section 3:  ---
 // ============================================================================
@@ -4,9 +4,20 @@
 //   **已修正**: 修复了由于部分地址译码导致的地址别名冲突问题。
 //   读操作逻辑被重构，优先判断完整的BRAM/ROM地址范围，
 //   然后再处理寄存器地址，从而解决了数据读取错误的问题。
+//   BRAM_PIPE=1 时 BRAM 窗口 (0x100 模拟缓存、0x400 捕获缓存、0x800 深存储视图) 走流水读：
+//   地址相位直接把 HADDR 送到 BRAM 读口，数据相位从 BRAM 输出口直接返回，
+//   下一次传输的地址相位与本次的数据相位重叠，零等待，每字 1 个 HCLK；
+//   寄存器读以及 BRAM_PIPE=0 (默认) 时的 BRAM 窗口走多拍状态机，每字 5 个 HCLK。
 // ============================================================================
 `timescale 1ns / 1ps
-module AHB2_SoC_Interface (
+module AHB2_SoC_Interface #(
+    // 1: BRAM 窗口零等待流水读，要求三个 BRAM 读口都是 bypass 方式 (地址打入后下一拍出数)，
+    //    开了输出寄存器 (pipeline 方式) 时会读到上一个字；
+    // 0: 全部走多拍状态机，bypass/pipeline 方式都能用。
+    //    DPB_AD 等 IP 的读方式在工程里无法确认 (没有这些 IP 的配置文件)，默认取 0，
+    //    在 IP 生成器里确认 Read Mode 为 Bypass 后再改成 1
+    parameter BRAM_PIPE = 0
+)(
     input  HCLK,
     input  AHB2HRESETn,
     input  AHB2HSEL,
@@ -14,7 +25,7 @@ module AHB2_SoC_Interface (
     input  [1:0]  AHB2HTRANS,
     input  AHB2HWRITE,
     input  [31:0] AHB2HWDATA,
-    output reg [31:0] AHB2HRDATA,
+    output wire [31:0] AHB2HRDATA,
     output reg AHB2HREADY,
     output wire [1:0] AHB2HRESP,
 
@@ -24,10 +35,26 @@ module AHB2_SoC_Interface (
     // --- 模拟输入接口 ---
     output reg analog_preview_start,
     input  analog_data_ready,
+    input  analog_data_bank,             // 乒乓缓冲：当前可读 bank
     output reg analog_data_ack,
-    input  [7:0] analog_bram_dout,
-    output reg [8:0] analog_bram_addr,
-    output wire [15:0] analog_decim_val, // ★ 新增：模拟输入时基（Decimation）控制输出 ★
+    input  [31:0] analog_bram_dout,      // 4 个样点打包为一个字（小端）
+    output wire [6:0] analog_bram_addr,  // 字地址 0..127
+    output wire [19:0] analog_decim_val, // ★ 新增：模拟输入时基（Decimation）控制输出 ★ [15:0]=N, [17:16]=抽取方式, [18]=滚动, [19]=双通道
+    output wire [27:0] analog_trig_cfg,  // 触发配置 (0x3C)
+    input  [9:0]  analog_trig_pos,       // 已发布帧的 {HIT, 起点地址} (0x40)
+    input  [15:0] analog_roll_pos,       // 滚动方式已写入的点数 (0x38)
+    input  [15:0] analog_drop_cnt,       // 统计：丢弃的帧数 (0x48)
+    input  [31:0] analog_discard_cnt,    // 统计：丢弃帧里的 ADC 样点数 (0x50)
+
+    // --- 深存储 (DDR3) 采集接口 ---
+    output wire [4:0]  deep_ctrl,        // [0] 采集脉冲, [1] 视图脉冲, [3:2] 视图方式, [4] 通道 (0x58)
+    output wire [20:0] deep_len,         // 记录长度 (0x5C)
+    output wire [15:0] deep_decim,       // 采集抽取值 (0x60)
+    output wire [19:0] deep_view_start,  // 视图起点 (0x64)
+    output wire [15:0] deep_view_step,   // 视图步长 (0x68)
+    input  [5:0]  deep_status,           // 深存储状态 (0x6C)
+    output wire [6:0] deep_view_addr,    // 视图缓存字地址 0..127
+    input  [31:0] deep_view_dout,        // 视图缓存 (0x800..0x9FF)
 
     // --- 数字测量 (基础) 接口 ---
     output reg digital_meas_start,
@@ -40,12 +67,15 @@ module AHB2_SoC_Interface (
     output reg digital_capture_ack,
     input  digital_capture_ready,
     input  [31:0]      capture_bram_rdata,
-    output reg [4:0]   capture_bram_raddr,
+    output wire [4:0]  capture_bram_raddr,
 
     input  wire [31:0] digital_in_data,
 
     // USB CDC 模式接口 
     output wire usb_cdc_start,
+
+    // 中断输出：接 M1 EXTINT[0]，高电平有效（= IRQ_STATUS & IRQ_ENABLE 非零）
+    output wire fpga_irq,
 
 
     output wire uart_tx_debug
@@ -66,19 +96,34 @@ module AHB2_SoC_Interface (
     reg [31:0] digital_control_reg;
     reg [31:0] digital_capture_control_reg;
     reg [31:0] analog_decim_reg;// ★ 新增：时基寄存器 ★
+    reg [31:0] analog_trig_reg;  // 触发寄存器
+    reg [31:0] deep_ctrl_reg;    // 深存储控制
+    reg [31:0] deep_len_reg;
+    reg [31:0] deep_decim_reg;
+    reg [31:0] deep_view_start_reg;
+    reg [31:0] deep_view_step_reg;
+    reg        deep_cap_pulse, deep_view_pulse;
     reg [31:0] usb_cdc_control_reg;
     assign main_mode_select = mode_select_reg[3:0];
     assign MODE_DDS = dds_control_reg[11:0];
 
     // (如果M1写入0或太小的值，我们将在 adc_decim_dpb 模块中处理默认值)
-    assign analog_decim_val = analog_decim_reg[15:0];
+    assign analog_decim_val = analog_decim_reg[19:0];
+    assign analog_trig_cfg  = analog_trig_reg[27:0];
+    assign deep_ctrl        = {deep_ctrl_reg[4:2], deep_view_pulse, deep_cap_pulse};
+    assign deep_len         = deep_len_reg[20:0];
+    assign deep_decim       = deep_decim_reg[15:0];
+    assign deep_view_start  = deep_view_start_reg[19:0];
+    assign deep_view_step   = deep_view_step_reg[15:0];
     assign usb_cdc_start = usb_cdc_control_reg[0];
     // --- 单一的寄存器写操作 always 块 ---
     always @(posedge HCLK or negedge AHB2HRESETn) begin
         if (!AHB2HRESETn){
              mode_select_reg, dds_control_reg, analog_control_reg,
               digital_control_reg, digital_capture_control_reg ,            
-              analog_decim_reg , usb_cdc_control_reg  } <= 0;// ★ 新增：复位时基寄存器 ★
+              analog_decim_reg , usb_cdc_control_reg, analog_trig_reg,
+              deep_ctrl_reg, deep_len_reg, deep_decim_reg,
+              deep_view_start_reg, deep_view_step_reg  } <= 0;// ★ 新增：复位时基寄存器 ★
               
         else if (wr_en) begin
             // 注意: 此处的部分译码对于没有地址重叠的稀疏寄存器是可接受的，但不是最佳实践
@@ -90,6 +135,12 @@ module AHB2_SoC_Interface (
                 6'h08: digital_capture_control_reg <= AHB2HWDATA;
                 6'h0A: analog_decim_reg          <= AHB2HWDATA; // ★ 新增：处理对 0x28 (即 6'h0A) 的写入 ★
                 6'h0B: usb_cdc_control_reg       <= AHB2HWDATA; // (0x2C)
+                6'h0F: analog_trig_reg           <= AHB2HWDATA; // (0x3C)
+                6'h16: deep_ctrl_reg             <= AHB2HWDATA; // (0x58)
+                6'h17: deep_len_reg              <= AHB2HWDATA; // (0x5C)
+                6'h18: deep_decim_reg            <= AHB2HWDATA; // (0x60)
+                6'h19: deep_view_start_reg       <= AHB2HWDATA; // (0x64)
+                6'h1A: deep_view_step_reg        <= AHB2HWDATA; // (0x68)
                 default: ;
             endcase
         end
@@ -105,30 +156,67 @@ module AHB2_SoC_Interface (
     reg [2:0] read_state;
     reg [31:0] addr_reg;
     reg [31:0] bram_data_latch;
+    reg [31:0] rdata_reg;            // 状态机读出的数据
+    reg [6:0]  analog_bram_addr_r;
+    reg [4:0]  capture_bram_raddr_r;
+    reg [6:0]  deep_view_addr_r;
+
+    // --- BRAM 窗口流水读 ---
+    wire in_analog_win  = (AHB2HADDR >= 32'h81000100) && (AHB2HADDR < 32'h81000300);
+    wire in_capture_win = (AHB2HADDR >= 32'h81000400) && (AHB2HADDR < 32'h81000800);
+    wire in_deep_win    = (AHB2HADDR >= 32'h81000800) && (AHB2HADDR < 32'h81000A00);
+    // 只在状态机空闲 (HREADY 为高) 时接受地址相位
+    wire pipe_rd = (BRAM_PIPE != 0) && rd_en && (read_state == R_IDLE) &&
+                   (in_analog_win || in_capture_win || in_deep_win);
+    reg        pipe_dp;              // 1: 本拍是流水读的数据相位
+    reg [1:0]  pipe_sel;             // 数据相位返回哪个 BRAM：0 模拟，1 捕获，2 深存储
+
+    always @(posedge HCLK or negedge AHB2HRESETn) begin
+        if (!AHB2HRESETn) begin
+            pipe_dp  <= 1'b0;
+            pipe_sel <= 2'd0;
+        end else begin
+            pipe_dp  <= pipe_rd;
+            if (pipe_rd)
+                pipe_sel <= in_analog_win ? 2'd0 : (in_capture_win ? 2'd1 : 2'd2);
+        end
+    end
+
+    // 流水方式下 BRAM 读地址直接取自地址相位的 HADDR (窗口基址的低位为 0，减基址只影响高位)
+    assign analog_bram_addr   = BRAM_PIPE ? (AHB2HADDR[8:2] - 7'h40) : analog_bram_addr_r;
+    assign capture_bram_raddr = BRAM_PIPE ? AHB2HADDR[6:2]           : capture_bram_raddr_r;
+    assign deep_view_addr     = BRAM_PIPE ? AHB2HADDR[8:2]           : deep_view_addr_r;
+
+    assign AHB2HRDATA = pipe_dp ? ((pipe_sel == 2'd0) ? analog_bram_dout :
+                                   (pipe_sel == 2'd1) ? capture_bram_rdata : deep_view_dout)
+                                : rdata_reg;
 
     always @(posedge HCLK or negedge AHB2HRESETn) begin
         if (!AHB2HRESETn) begin
             read_state <= R_IDLE;
             AHB2HREADY <= 1'b1;
-            AHB2HRDATA <= 32'd0;
-            analog_bram_addr <= 9'd0;
-            capture_bram_raddr <= 5'd0;
+            rdata_reg  <= 32'd0;
+            analog_bram_addr_r <= 7'd0;
+            capture_bram_raddr_r <= 5'd0;
+            deep_view_addr_r <= 7'd0;
             bram_data_latch <= 32'd0;
         end else begin
             AHB2HREADY <= 1'b1; // 默认就绪
 
             case (read_state)
                 R_IDLE: begin
-                    if (rd_en) begin
+                    if (rd_en && !pipe_rd) begin
                         addr_reg <= AHB2HADDR;
                         AHB2HREADY <= 1'b0; 
                         read_state <= R_WAIT1; 
                         
                         // BRAM地址生成 (此部分逻辑正确)
                         if ((AHB2HADDR >= 32'h81000400) && (AHB2HADDR < 32'h81000800)) begin
-                            capture_bram_raddr <= (AHB2HADDR - 32'h81000400) >> 2;
+                            capture_bram_raddr_r <= (AHB2HADDR - 32'h81000400) >> 2;
                         end else if ((AHB2HADDR >= 32'h81000100) && (AHB2HADDR < 32'h81000300)) begin
-                            analog_bram_addr <= AHB2HADDR - 32'h81000100;
+                            analog_bram_addr_r <= (AHB2HADDR - 32'h81000100) >> 2;
+                        end else if ((AHB2HADDR >= 32'h81000800) && (AHB2HADDR < 32'h81000A00)) begin
+                            deep_view_addr_r <= (AHB2HADDR - 32'h81000800) >> 2;
                         end
                     end
                 end
@@ -155,29 +243,38 @@ module AHB2_SoC_Interface (
 
                     // 优先级 1: 模拟信号 ROM
                     if ((addr_reg >= 32'h81000100) && (addr_reg < 32'h81000300)) begin
-                        // 此处处理字节到32位字的转换，对于纯C语言指针访问可能是非预期的，
-                        // 但我们保留此逻辑因为它在您之前的设计中是工作的。
-                        case (addr_reg[1:0])
-                            2'b00:  AHB2HRDATA <= {24'h0, analog_bram_dout};
-                            2'b01:  AHB2HRDATA <= {16'h0, analog_bram_dout, 8'h0};
-                            2'b10:  AHB2HRDATA <= {8'h0, analog_bram_dout, 16'h0};
-                            2'b11:  AHB2HRDATA <= {analog_bram_dout, 24'h0};
-                        endcase
+                        // 每个字直接返回 4 个样点 {s[4k+3],s[4k+2],s[4k+1],s[4k]}。
+                        // 字节读取时 CPU 按 HADDR[1:0] 取对应字节通道，仍然兼容 uint8_t* 访问。
+                        rdata_reg  <= analog_bram_dout;
                     end
                     // 优先级 2: 数字捕获 BRAM
                     else if ((addr_reg >= 32'h81000400) && (addr_reg < 32'h81000800)) begin
-                        AHB2HRDATA <= bram_data_latch;
+                        rdata_reg  <= bram_data_latch;
+                    end
+                    // 优先级 3: 深存储视图缓存 (4 个样点一字，小端)
+                    else if ((addr_reg >= 32'h81000800) && (addr_reg < 32'h81000A00)) begin
+                        rdata_reg  <= deep_view_dout;
                     end
-                    // 优先级 3: 寄存器区域
+                    // 优先级 4: 寄存器区域
                     else begin
                         case (addr_reg[7:2])
-                            6'h03:  AHB2HRDATA <= {31'b0, analog_data_ready};       // 0x0C
-                            6'h05:  AHB2HRDATA <= {31'b0, digital_meas_ready};      // 0x14
-                            6'h06:  AHB2HRDATA <= digital_period_in;               // 0x18
-                            6'h07:  AHB2HRDATA <= digital_hightime_in;             // 0x1C
-                            6'h09:  AHB2HRDATA <= {31'b0, digital_capture_ready};   // 0x24
+                            6'h03:  rdata_reg  <= {30'b0, analog_data_bank, analog_data_ready}; // 0x0C
+                            6'h05:  rdata_reg  <= {31'b0, digital_meas_ready};      // 0x14
+                            6'h06:  rdata_reg  <= digital_period_in;               // 0x18
+                            6'h07:  rdata_reg  <= digital_hightime_in;             // 0x1C
+                            6'h09:  rdata_reg  <= {31'b0, digital_capture_ready};   // 0x24
+                            6'h0C:  rdata_reg  <= {29'b0, irq_status_reg};          // 0x30
+                            6'h0D:  rdata_reg  <= {29'b0, irq_enable_reg};          // 0x34
+                            6'h0E:  rdata_reg  <= {16'b0, analog_roll_pos};         // 0x38
+                            6'h10:  rdata_reg  <= {22'b0, analog_trig_pos};         // 0x40
+                            6'h11:  rdata_reg  <= stat_frames;                      // 0x44
+                            6'h12:  rdata_reg  <= {16'b0, analog_drop_cnt};         // 0x48
+                            6'h13:  rdata_reg  <= stat_ack_lat;                     // 0x4C
+                            6'h14:  rdata_reg  <= analog_discard_cnt;               // 0x50
+                            6'h15:  rdata_reg  <= stat_ticks;                       // 0x54
+                            6'h1B:  rdata_reg  <= {26'b0, deep_status};             // 0x6C
                             // 注意: 其他寄存器(如控制寄存器)是只写的，无需在此处处理读操作
-                            default: AHB2HRDATA <= 32'hDEADBEEF; // 对于未定义的地址返回一个明显错误的值
+                            default: rdata_reg  <= 32'hDEADBEEF; // 对于未定义的地址返回一个明显错误的值
                         endcase
                     end
                     // ====================== 修正结束 ======================
@@ -198,6 +295,8 @@ module AHB2_SoC_Interface (
             digital_meas_ack       <= 0;
             digital_capture_start  <= 0;
             digital_capture_ack    <= 0;
+            deep_cap_pulse         <= 0;
+            deep_view_pulse        <= 0;
         end
         else begin
             analog_preview_start <= analog_control_reg[0];
@@ -217,6 +316,74 @@ module AHB2_SoC_Interface (
                 digital_capture_ack <= 1;
             else
                 digital_capture_ack <= 0;
+
+            // 深存储：写 DEEP_CTRL 时 bit0/bit1 各产生一拍请求脉冲
+            deep_cap_pulse  <= wr_en && (AHB2HADDR[7:2] == 6'h16) && AHB2HWDATA[0];
+            deep_view_pulse <= wr_en && (AHB2HADDR[7:2] == 6'h16) && AHB2HWDATA[1];
+        end
+    end
+
+// ========================================================================
+// Section 2: 中断 (数据就绪通知)
+//   IRQ_STATUS (0x30): bit0 模拟预览 READY, bit1 数字测量 READY, bit2 数字捕获 READY
+//                      各 READY 上升沿置位，写 1 清零
+//   IRQ_ENABLE (0x34): 对应位为 1 时该中断源驱动 fpga_irq
+// ========================================================================
+    reg [2:0] irq_status_reg;
+    reg [2:0] irq_enable_reg;
+    reg [2:0] irq_src_d;
+    wire [2:0] irq_src      = {digital_capture_ready, digital_meas_ready, analog_data_ready};
+    wire [2:0] irq_src_rise = irq_src & ~irq_src_d;
+    wire [2:0] irq_w1c      = (wr_en && (AHB2HADDR[7:2] == 6'h0C)) ? AHB2HWDATA[2:0] : 3'b000;
+
+    always @(posedge HCLK or negedge AHB2HRESETn) begin
+        if (!AHB2HRESETn) begin
+            irq_src_d      <= 3'b000;
+            irq_status_reg <= 3'b000;
+            irq_enable_reg <= 3'b000;
+        end else begin
+            irq_src_d <= irq_src;
+            // 同拍既有新边沿又有写 1 清零时，保留新边沿，避免丢中断
+            irq_status_reg <= (irq_status_reg & ~irq_w1c) | irq_src_rise;
+            if (wr_en && (AHB2HADDR[7:2] == 6'h0D))
+                irq_enable_reg <= AHB2HWDATA[2:0];
+        end
+    end
+
+    assign fpga_irq = |(irq_status_reg & irq_enable_reg);
+
+// ========================================================================
+// Section 3: 模拟预览统计 (只读，均为自由回绕计数，M1 取两次读数之差)
+//   STAT_FRAMES  (0x44): 发布的帧数 (READY 上升沿)
+//   STAT_DROPS   (0x48): 上一帧未 ACK 而丢弃的帧数 (来自 adc_decim_dpb)
+//   STAT_ACK_LAT (0x4C): 最近一帧从 READY 置位到 M1 写 ACK 的 HCLK 周期数
+//   STAT_DISCARD (0x50): 丢弃帧里的 ADC 样点数 (来自 adc_decim_dpb)
+//   STAT_TICKS   (0x54): HCLK 周期计数，M1 用来换算帧率
+// ========================================================================
+    reg [31:0] stat_frames;
+    reg [31:0] stat_ack_lat;
+    reg [31:0] stat_ack_run;   // 本帧 READY 以来的周期数，0 表示本帧已 ACK (不再计数)
+    reg [31:0] stat_ticks;
+
+    always @(posedge HCLK or negedge AHB2HRESETn) begin
+        if (!AHB2HRESETn) begin
+            stat_frames  <= 32'd0;
+            stat_ack_lat <= 32'd0;
+            stat_ack_run <= 32'd0;
+            stat_ticks   <= 32'd0;
+        end else begin
+            stat_ticks <= stat_ticks + 32'd1;
+            if (irq_src_rise[0]) begin
+                stat_frames  <= stat_frames + 32'd1;
+                stat_ack_run <= 32'd1;
+            end else if ((stat_ack_run != 32'd0) && (stat_ack_run != 32'hFFFFFFFF)) begin
+                stat_ack_run <= stat_ack_run + 32'd1;
+            end
+            // ACK 写入时锁存 (只算 READY 期间的第一次 ACK)
+            if (analog_data_ack && analog_data_ready && (stat_ack_run != 32'd0)) begin
+                stat_ack_lat <= stat_ack_run;
+                stat_ack_run <= 32'd0;
+            end
         end
     end
     
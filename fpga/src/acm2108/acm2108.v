@@ -65,9 +65,25 @@ module acm2108 (
     input  wire        analog_preview_start,   // START（ANALOG_CONTROL bit0）
     input  wire        analog_data_ack,        // ACK   （ANALOG_CONTROL bit1）
     output wire        analog_data_ready,      // READY （ANALOG_STATUS bit0）
-    input  wire [8:0]  analog_bram_addr,       // DATA BUFFER 地址 0..511
-    output wire [7:0]  analog_bram_dout,       // DATA BUFFER 读数据
-    input  wire [15:0] decim_control_wire,
+    output wire        analog_data_bank,       // BANK  （ANALOG_STATUS bit1，乒乓缓冲当前可读 bank）
+    input  wire [6:0]  analog_bram_addr,       // DATA BUFFER 字地址 0..127
+    output wire [31:0] analog_bram_dout,       // DATA BUFFER 读数据（4 个样点）
+    input  wire [19:0] decim_control_wire,     // [15:0] 抽取值 N，[17:16] 抽取方式，[18] 滚动，[19] 双通道
+    input  wire [27:0] trig_control_wire,      // 触发配置（ANALOG_TRIG_REG）
+    output wire [9:0]  analog_trig_pos,        // {HIT, 帧起点地址}（ANALOG_TRIG_POS）
+    output wire [15:0] analog_roll_pos,        // 滚动方式已写入的点数（ANALOG_ROLL_POS）
+    output wire [15:0] analog_drop_cnt,        // 统计：丢弃的帧数
+    output wire [31:0] analog_discard_cnt,     // 统计：丢弃帧里的 ADC 样点数
+
+    // ====== 深存储（DDR3）采集 ======
+    input  wire [4:0]  deep_ctrl_wire,         // [0] 采集脉冲，[1] 视图脉冲，[3:2] 视图方式，[4] 通道
+    input  wire [20:0] deep_len_wire,          // 记录长度（样点）
+    input  wire [15:0] deep_decim_wire,        // 采集抽取值
+    input  wire [19:0] deep_view_start_wire,   // 视图起点（样点序号）
+    input  wire [15:0] deep_view_step_wire,    // 视图步长
+    output wire [5:0]  deep_status,            // DEEP_STATUS
+    input  wire [6:0]  deep_view_addr,         // 视图缓存字地址 0..127
+    output wire [31:0] deep_view_dout,         // 视图缓存读数据（4 个样点）
 
     output clk_50M,
     output AD_Clk,
@@ -165,6 +181,8 @@ module acm2108 (
   wire          rdfifo_clr;
   wire          rdfifo_rden;
   wire  [15:0]  rdfifo_dout;
+  wire          deep_own;      // 深存储采集占用 DDR 用户口
+  wire          deep_busy;
 
   assign eth_rst_n = 1'b1;
   assign eth_mdc   = 1'b1;
@@ -227,6 +245,8 @@ wire ch_sel_adc = ch_sel_a_d2;
 // 4) 预览链路的数据与有效（与以太网完全解耦）
 wire ch_sel_preview = (ChannelSel[1:0] == 2'b10) ? 1'b1 : 1'b0; // 1:AD1, 0:AD0
 wire [7:0] adc_preview_data = ch_sel_preview ? AD1 : AD0;
+// 双通道预览：A 口固定 AD0，B 口 AD1，与 ChannelSel 无关
+wire       preview_dual     = decim_control_wire[19];
 
 // 预览期间在 ADC 域恒为 1，由 dpb 内 decim_cnt 负责抽取
 reg allow_prev_a_d1, allow_prev_a_d2;
@@ -240,7 +260,8 @@ always @(posedge adc_clk_fe or negedge rst_adc_n) begin
   end
 end
 wire        adc_valid_25m = allow_prev_a_d2;
-wire [7:0]  adc_data_25m  = adc_preview_data;
+wire [7:0]  adc_data_25m  = preview_dual ? AD0 : adc_preview_data;
+wire [7:0]  adc_data_b_25m = AD1;
 
 // 以太网忙门控：由顶层仲裁生成
 wire eth_active = eth_in_progress;
@@ -407,7 +428,9 @@ wire g_reset_200M   = g_reset_50M;
 // ========================== PATCH A: 互斥仲裁 + 以太网忙标志 ==========================
 // 预览优先：有预览就不允许以太网启动；以太网忙时，预览保持复位&停写。
 
-// 1) 预览活动标志（analog_preview_start 置位，analog_data_ack 清零）
+// 1) 预览活动标志（跟随 analog_preview_start 电平）
+//    降频缓存已改为乒乓双缓冲，ACK 只释放已读 bank，不再停止预览；
+//    以前 ACK 清 preview_active，固件每帧都要 STOP→START 重启采集
 reg prev_start_d, prev_ack_d;
 always @(posedge HCLK or negedge HRESETn) begin
   if(!HRESETn) begin
@@ -425,9 +448,9 @@ reg preview_active;
 always @(posedge HCLK or negedge HRESETn) begin
   if(!HRESETn) preview_active <= 1'b0;
   else begin
-    if (analog_start_pulse) preview_active <= 1'b1;     //analog_start_pulse 降频模块工作
-    else if (analog_ack_pulse) preview_active <= 1'b0;  //analog_ack_pulse 以太网工作
-                                                        //后面接到start_sample_to_eth信号共同控制
+    if (analog_start_pulse)         preview_active <= 1'b1;  //analog_start_pulse 降频模块工作
+    else if (!analog_preview_start) preview_active <= 1'b0;  //STOP 后以太网工作
+                                                             //后面接到start_sample_to_eth信号共同控制
   end
 end
 
@@ -448,8 +471,8 @@ always @(posedge HCLK or negedge HRESETn) begin
   end
 end
 
-// 4) 门控后的以太网启动（直接用你现成的 RestartReq_0_d1）
-wire start_sample_to_eth = RestartReq_0_d1 & allow_eth;
+// 4) 门控后的以太网启动（直接用你现成的 RestartReq_0_d1）；深存储占用 DDR 期间也不启动
+wire start_sample_to_eth = RestartReq_0_d1 & allow_eth & ~deep_busy;
 // ========================== PATCH A END ==========================
 ad_8bit_to_16bit u_ad_8bit_to_16bit(
     .clk         (AD_Clk),
@@ -505,6 +528,47 @@ ad_8bit_to_16bit u_ad_8bit_to_16bit(
   wire [27:0] app_addr_max = 28'd268435455; // 256MB-1
   wire [7:0]  burst_len    = 8'd128;
 
+  // ================== 深存储采集：占用 DDR 期间接管用户口 ==================
+  wire        deep_wr_load, deep_rd_load;
+  wire [27:0] deep_rd_min;
+  wire        deep_wren;
+  wire [15:0] deep_din;
+  wire        deep_rden;
+
+  ddr_deep_capture u_deep (
+    .clk           (clk_50M),
+    .rst           (g_reset_50M),
+    .ddr_init_done (ddr3_init_done),
+    .eth_busy      (eth_in_progress),
+    .adc_clk       (AD_Clk),
+    .adc_data0     (AD0),
+    .adc_data1     (AD1),
+    .HCLK          (HCLK),
+    .HRESETn       (HRESETn),
+    .cap_pulse     (deep_ctrl_wire[0]),
+    .view_pulse    (deep_ctrl_wire[1]),
+    .view_mode     (deep_ctrl_wire[3:2]),
+    .cap_ch        (deep_ctrl_wire[4]),
+    .cap_len       (deep_len_wire),
+    .cap_decim     (deep_decim_wire),
+    .view_start    (deep_view_start_wire),
+    .view_step     (deep_view_step_wire),
+    .deep_status   (deep_status),
+    .view_addr     (deep_view_addr),
+    .view_dout     (deep_view_dout),
+    .deep_own      (deep_own),
+    .deep_busy     (deep_busy),
+    .ddr_wr_load   (deep_wr_load),
+    .ddr_rd_load   (deep_rd_load),
+    .ddr_rd_min    (deep_rd_min),
+    .ddr_wren      (deep_wren),
+    .ddr_din       (deep_din),
+    .ddr_wr_full   (wrfifo_full),
+    .ddr_rden      (deep_rden),
+    .ddr_rd_empty  (rdfifo_empty),
+    .ddr_dout      (rdfifo_dout)
+  );
+
   // ================== DDR3 控制器（统一同源接法） ==================
   ddr3_ctrl_2port u_ddr3 (
     .clk                 (clk_50M),
@@ -515,9 +579,9 @@ ad_8bit_to_16bit u_ad_8bit_to_16bit(
     .init_calib_complete (ddr3_init_done),
 
     // 用户接口
-    .rd_load             (rdfifo_clr),
-    .wr_load             (wrfifo_clr),
-    .app_addr_rd_min     (28'd0),
+    .rd_load             (deep_own ? deep_rd_load : rdfifo_clr),
+    .wr_load             (deep_own ? deep_wr_load : wrfifo_clr),
+    .app_addr_rd_min     (deep_own ? deep_rd_min  : 28'd0),
     .app_addr_rd_max     (app_addr_max),
     .rd_bust_len         (burst_len),
     .app_addr_wr_min     (28'd0),
@@ -525,12 +589,12 @@ ad_8bit_to_16bit u_ad_8bit_to_16bit(
     .wr_bust_len         (burst_len),
 
     .wr_clk              (clk_50M),
-    .wfifo_wren          (ad_out_valid && adc_data_en),
-    .wfifo_din           (ad_out),
+    .wfifo_wren          (deep_own ? deep_wren : (ad_out_valid && adc_data_en)),
+    .wfifo_din           (deep_own ? deep_din  : ad_out),
     .wrfifo_full         (wrfifo_full),
 
     .rd_clk              (clk_50M),
-    .rfifo_rden          (rdfifo_rden),
+    .rfifo_rden          (deep_own ? deep_rden : rdfifo_rden),
     .rdfifo_empty        (rdfifo_empty),
     .rfifo_dout          (rdfifo_dout),
 
@@ -653,6 +717,7 @@ adc_decim_dpb #(
   .adc_rstn             (adc_decim_rstn),        // 高有效
   .adc_valid            (adc_valid_25m),
   .adc_data             (adc_data_25m),
+  .adc_data_b           (adc_data_b_25m),        // 双通道方式的第二路
 
   // 读口 @ HCLK 域
   .HCLK                 (HCLK),
@@ -662,7 +727,16 @@ adc_decim_dpb #(
   .analog_preview_start (analog_preview_start),
   .analog_data_ack      (analog_data_ack),
   .analog_data_ready    (analog_data_ready),
-  .decim_val_in         (decim_control_wire),  //新增的时基调节端口
+  .analog_data_bank     (analog_data_bank),
+  .decim_val_in         (decim_control_wire[15:0]),  //新增的时基调节端口
+  .decim_mode_in        (decim_control_wire[17:16]), //抽取方式：0 取样，1 峰值
+  .decim_roll_in        (decim_control_wire[18]),    //滚动方式
+  .decim_dual_in        (decim_control_wire[19]),    //双通道
+  .trig_cfg_in          (trig_control_wire),
+  .analog_trig_pos      (analog_trig_pos),
+  .analog_roll_pos      (analog_roll_pos),
+  .analog_drop_cnt      (analog_drop_cnt),
+  .analog_discard_cnt   (analog_discard_cnt),
   // AHB2 数据窗口（0..511）
   .analog_bram_addr     (analog_bram_addr),
   .analog_bram_dout     (analog_bram_dout),
@@ -1,9 +1,32 @@
 // ============================================================================
-// 降频缓存模块（DPB 双口RAM版）
-//  - A口：adc_clk 域写入（每 N 取 1）
-//  - B口：HCLK   域读出 512 字节
-//  目标：READY=1（满帧）→ M1 读 0..511 → M1 发 ACK → 清 READY → 写侧收 ACK 清指针 → 下一帧
-//  约束：不改 SoC 顶层通信，只在本模块内自洽完成握手。
+// 降频缓存模块（DPB 双口RAM版，乒乓双缓冲）
+//  - A口：adc_clk 域写入，抽取方式由 decim_mode_in 选择：
+//      0 = 取样：每 N 点取 1 点，512 个 8 位样点
+//      1 = 峰值：每 2N 点一个窗口，写入窗口内的 min（地址 2k）和 max（地址 2k+1），共 256 对
+//      2 = 平均：每 2N 点一个窗口，写入窗口均值的 Q8.8 定点数（低字节=小数，地址 2k；
+//          高字节=整数，地址 2k+1），共 256 个 16 位样点
+//    峰值/平均模式每帧覆盖的时间与取样模式相同；峰值模式窗口内的毛刺不会丢失，
+//    平均模式滤除噪声并得到高于 8 位的有效分辨率
+//  - 触发：写侧按环形缓冲连续写，对每个写入的样点做电平比较（上升/下降沿，带回差），
+//    先写满预触发深度，再等触发，触发后再写 512-预触发 个字节即满帧；
+//    帧起点（最早样点）地址随帧发布，M1 读 TRIG_POS 后按该地址旋转缓冲区。
+//    关触发时预触发为 0、首个样点即"触发"，行为与原来从 0 顺序写满相同；
+//    自动方式下等满一整圈仍无边沿则强制出帧（TRIG_POS.HIT=0）
+//  - 滚动方式（慢时基）：不分帧、不发布、不理会触发，写侧在 wr_bank 里一直环形写，
+//    每写一个点（成对方式为一个窗口）计数加 1，计数以格雷码同步到 HCLK 域（ANALOG_ROLL_POS），
+//    M1 按计数差只读新写入的点，不必等一整帧写满
+//  - 双通道方式（decim_dual_in）：强制取样，每 N 点写一对 {adc_data（地址 2k）, adc_data_b（地址 2k+1）}，
+//    每帧 256 对，两路在同一个 32 位字里交错，M1 一次读出即得两路；触发只看 adc_data；
+//    每帧覆盖 256*N 点，M1 把 N 加倍使时基不变
+//  - B口：HCLK   域按 32 位字读出 512 字节（128 字）
+//  - 两个 512 字节 bank：写侧连续写 wr_bank，满帧后发布给 M1 并切到另一 bank 继续写，
+//    M1 读已发布 bank 期间采集不停，帧间死区只剩 ACK 往返。
+//  目标：READY=1（满帧）→ M1 读 0..511 → M1 发 ACK → 清 READY → 写侧收 ACK 释放已发布 bank
+//  若上一帧还没被 ACK 时又写满一帧，则丢弃该帧，在同一 bank 重新写（M1 永远读到完整帧）。
+//  统计：丢弃的帧数和这些帧里的 ADC 样点数在 adc_clk 域累计，每次丢帧后随 toggle 同步到 HCLK 域
+//  流水线：窗口最后一个样点所在的拍把待写数据打入 s1，下一拍平均方式的乘法结果打入 s2，
+//    再下一拍（wr_s2）才写 RAM、判触发、满帧发布，乘法与触发/发布不在同一拍。
+//    抽取值至少为 5，两次写入至少相隔 5 拍，流水线里最多只有一个在途的写入
 // ============================================================================
 
 module adc_decim_dpb #(
@@ -15,6 +38,7 @@ module adc_decim_dpb #(
     input  wire                 adc_rstn,             // 低有效：1=正常，0=复位
     input  wire                 adc_valid,
     input  wire [7:0]           adc_data,
+    input  wire [7:0]           adc_data_b,           // 双通道方式的第二路（地址 2k+1）
 
     // 读侧（HCLK 域）
     input  wire                 HCLK,
@@ -24,12 +48,24 @@ module adc_decim_dpb #(
     input  wire                 analog_preview_start, // START（AHB 域锁存后送来）
     input  wire                 analog_data_ack,      // 上层 ACK（此版按脉冲上升沿处理）
     output wire                 analog_data_ready,    // READY（HCLK 域粘性位）
+    output wire                 analog_data_bank,     // 当前发布给 M1 的 bank（ANALOG_STATUS bit1）
 
     input  wire [15:0]          decim_val_in,
+    input  wire [1:0]           decim_mode_in,        // 抽取方式（ANALOG_DECIM_REG[17:16]）
+    input  wire                 decim_roll_in,        // 滚动方式（ANALOG_DECIM_REG[18]）
+    input  wire                 decim_dual_in,        // 双通道（ANALOG_DECIM_REG[19]）
 
-    // 预览数据 BRAM 读口（HCLK 域）
-    input  wire [8:0]           analog_bram_addr,
-    output wire [7:0]           analog_bram_dout,
+    // 触发配置（ANALOG_TRIG_REG）：[7:0] 电平，[15:8] 回差，[24:16] 预触发字节数，
+    //                              [25] 斜率 0=上升 1=下降，[26] 使能，[27] 自动
+    input  wire [27:0]          trig_cfg_in,
+    output wire [9:0]           analog_trig_pos,      // {HIT, 帧起点地址[8:0]}，随已发布的帧锁存
+    output wire [15:0]          analog_roll_pos,      // 滚动方式：已写入的点数（回绕），第 k 点在地址 k*步长 mod 512
+    output reg  [15:0]          analog_drop_cnt,      // 统计：因上一帧未 ACK 而丢弃的帧数（回绕）
+    output reg  [31:0]          analog_discard_cnt,   // 统计：丢弃帧里的 ADC 样点数（回绕）
+
+    // 预览数据 BRAM 读口（HCLK 域，32 位字：4 个样点，小端排列）
+    input  wire [6:0]           analog_bram_addr,     // 字地址 0..127
+    output wire [31:0]          analog_bram_dout,
 
     // 可选：以太网占用门控（本模块未使用；保持端口不改 SoC）
     input  wire                 eth_active
@@ -40,12 +76,40 @@ module adc_decim_dpb #(
     // ---------------------------------------------
     localparam integer ADDR_W  = 9; // 0..511
 
+    localparam [1:0] MODE_SAMPLE = 2'd0;
+    localparam [1:0] MODE_PEAK   = 2'd1;
+    localparam [1:0] MODE_AVG    = 2'd2;
+
     // 如果 M1 写入的值小于 5 (您的极限值)，则强制使用 DEFAULT_DECIM
     wire [15:0] current_decim_val = (decim_val_in < 5) ? DEFAULT_DECIM[15:0] : decim_val_in;
+    // 未定义的方式按取样处理；双通道方式固定取样
+    wire [1:0]  current_mode      = decim_dual_in                ? MODE_SAMPLE :
+                                    (decim_mode_in == MODE_PEAK) ? MODE_PEAK :
+                                    (decim_mode_in == MODE_AVG)  ? MODE_AVG  : MODE_SAMPLE;
+    // 成对写入的方式：窗口为 2N 点，每个窗口写两个字节（地址 2k、2k+1）
+    wire        pair_mode         = (current_mode != MODE_SAMPLE);
+    // 每次写两个字节（成对方式或双通道）
+    wire        two_byte          = pair_mode || decim_dual_in;
 
     reg  [ADDR_W-1:0] wptr;
     reg  [15:0]       decim_cnt;
     reg               frame_done_tgl_adc;
+    reg               wr_bank;             // 写侧正在写的 bank
+    reg               pub_bank_adc;        // 最近一次发布的 bank（发布后保持到下一次发布）
+    reg  [15:0]       decim_val_d;         // 上一拍抽取值，变化时丢弃半帧重新开始
+    reg  [1:0]        decim_mode_d;        // 上一拍抽取方式，同上
+    reg               roll_d;              // 上一拍滚动方式，同上
+    reg               dual_d;              // 上一拍双通道，同上
+    reg  [15:0]       roll_cnt;            // 滚动方式：已写入的点数
+    reg  [15:0]       roll_gray;           // roll_cnt 的格雷码（寄存器输出，跨域时每次只变 1 位）
+    reg               win_half;            // 成对方式：窗口的第二个 N 点
+    reg  [7:0]        run_min, run_max;    // 峰值方式：当前窗口（不含本拍）的最小/最大值
+    reg  [24:0]       run_sum;             // 平均方式：当前窗口（不含本拍）的累加和，2N ≤ 131070 点
+    reg  [27:0]       trig_cfg_d;          // 上一拍触发配置，变化时重新开始一帧
+    reg  [31:0]       frame_samples;       // 自上次发布/丢帧以来的 ADC 样点数
+    reg  [15:0]       drop_cnt_adc;        // 丢帧计数
+    reg  [31:0]       discard_adc;         // 丢弃的 ADC 样点累计
+    reg               drop_tgl_adc;        // 每丢一帧翻转一次，HCLK 域据此锁存上面两个计数
 
     // START 2FF 跨域同步到 adc_clk 域
     reg [1:0] start_sync;
@@ -58,86 +122,362 @@ module adc_decim_dpb #(
     // 写入门控（不把业务掺到复位）
     wire preview_enable = start_adc;
 
-    // 写侧抽取命中与写 RAM（先写后判满，地址 511 也写）
+    // 写侧抽取命中与写 RAM（先写后判满，最后一个地址也写）
     wire wr_hit   = adc_valid && (decim_cnt == (current_decim_val - 1));
-    wire wr_fire  = preview_enable & wr_hit;
-    wire last_addr= (wptr == 9'd511);
+    wire win_end  = wr_hit && (!pair_mode || win_half);
+
+    // 窗口统计（含本拍样点）
+    wire [7:0] win_min = (adc_data < run_min) ? adc_data : run_min;
+    wire [7:0] win_max = (adc_data > run_max) ? adc_data : run_max;
+
+    wire [24:0] win_sum = run_sum + adc_data;
+
+    // ---------------------------------------------
+    // 平均方式的除法：均值*256 = sum*256/(2N) = (sum * avg_recip) >> 24，
+    // avg_recip = floor(2^32 / (2N)) 在抽取值变化（及复位）后用移位减法逐位求出，
+    // 33 拍完成，期间写侧保持清零，不会用到旧的倒数
+    // ---------------------------------------------
+    wire [16:0] win_len = {current_decim_val, 1'b0};   // 2N
+    reg  [31:0] avg_recip;
+    reg  [31:0] div_quo;
+    reg  [16:0] div_rem;
+    reg  [5:0]  div_cnt;
+    reg         div_busy;
+    wire [17:0] div_rem_sh = {div_rem, (div_cnt == 6'd33)};   // 被除数 2^32：仅最高位为 1
+    wire        div_ge     = (div_rem_sh >= {1'b0, win_len});
+
+    // 写入流水线（见文件头）：s1 = 窗口结束时的统计/样点，s2 = 平均方式的乘积
+    reg         wr_s1, wr_s2;
+    reg  [7:0]  s1_lo, s1_hi, s2_lo, s2_hi;
+    reg  [24:0] s1_sum;
+    reg  [56:0] avg_prod;
+    reg  [31:0] s1_samples, s2_samples;   // 本帧到该窗口结束（含）的 ADC 样点数
+
+    wire [15:0] avg_q8   = avg_prod[39:24] + avg_prod[23];   // 四舍五入
+
+    // 写入的两个字节：成对方式下低地址放 lo、高地址放 hi；取样方式两者都是当前样点，
+    // 双通道时 hi 为第二路
+    wire [7:0] pair_lo = (current_mode == MODE_AVG) ? avg_q8[7:0]  : s2_lo;
+    wire [7:0] pair_hi = (current_mode == MODE_AVG) ? avg_q8[15:8] : s2_hi;
+    wire       wr_fire = preview_enable & wr_s2;
+
+    // ---------------------------------------------
+    // 触发：比较本拍写入的样点（峰值方式上升沿看 max、下降沿看 min，平均方式看整数部分）
+    //   上升沿：样点 + 回差 < 电平 时武装，武装后样点 >= 电平 即触发；下降沿对称
+    // ---------------------------------------------
+    localparam [1:0] ST_PRE  = 2'd0;   // 写预触发部分
+    localparam [1:0] ST_WAIT = 2'd1;   // 环形写，等触发
+    localparam [1:0] ST_POST = 2'd2;   // 已触发，写触发后部分
+
+    wire [7:0] trig_level = trig_cfg_in[7:0];
+    wire [7:0] trig_hyst  = trig_cfg_in[15:8];
+    wire       trig_slope = trig_cfg_in[25];
+    wire       trig_en    = trig_cfg_in[26];
+    wire       trig_auto  = trig_cfg_in[27];
+    // 预触发字节数：关触发时为 0；成对方式和双通道取偶数（一个窗口/一对占两个字节）
+    wire [8:0] pretrig    = !trig_en  ? 9'd0 :
+                            two_byte  ? {trig_cfg_in[24:17], 1'b0} : trig_cfg_in[24:16];
+
+    wire [7:0] trig_val   = (current_mode == MODE_AVG)  ? avg_q8[15:8] :
+                            (current_mode == MODE_PEAK) ? (trig_slope ? pair_lo : pair_hi) : pair_lo;
+    wire       trig_beyond = trig_slope ? ({1'b0, trig_val} > {1'b0, trig_level} + {1'b0, trig_hyst})
+                                        : ({1'b0, trig_val} + {1'b0, trig_hyst} < {1'b0, trig_level});
+    wire       trig_reach  = trig_slope ? (trig_val <= trig_level) : (trig_val >= trig_level);
+
+    reg  [1:0] trig_state;
+    reg        trig_armed;
+    reg  [9:0] fill_cnt;           // 当前状态下已写字节数（ST_WAIT 中用于自动超时）
+    reg  [8:0] frame_start;        // 本帧最早样点地址
+    reg        frame_hit;          // 本帧由真实边沿触发
+    reg  [8:0] pub_start_adc;      // 随 pub_bank_adc 一起发布
+    reg        pub_hit_adc;
+
+    wire       trig_cross = trig_armed && trig_reach;
+    wire [9:0] wr_step    = two_byte ? 10'd2 : 10'd1;
+    wire [9:0] fill_next  = fill_cnt + wr_step;
+    wire [9:0] post_len   = 10'd512 - pretrig;
+    wire [1:0] st_init    = (pretrig == 9'd0) ? ST_WAIT : ST_PRE;
+    // 本拍写入的样点即触发点：关触发时立即触发；自动方式等满一整圈仍无边沿则强制
+    wire       trig_now   = (trig_state == ST_WAIT) &&
+                            (!trig_en || trig_cross || (trig_auto && (fill_next >= 10'd512)));
+    wire [8:0] start_now  = wptr - pretrig;
+    // 滚动方式从不满帧：一直环形写，不发布
+    wire       frame_full = !decim_roll_in &&
+                            ((trig_state == ST_POST) ? (fill_next >= post_len)
+                                                     : (trig_now && (wr_step >= post_len)));
+    wire [15:0] roll_cnt_next = roll_cnt + 16'd1;
 
-    // 内部 ACK toggle（HCLK 域翻转 → adc_clk 域 2FF+XOR 检测）
+    // 内部 ACK toggle（HCLK 域翻转 → adc_clk 域 2FF 同步）
+    // 每发布一帧 frame_done_tgl_adc 翻转一次，M1 每 ACK 一帧 ack_tgl_local_h 翻转一次，
+    // 两者不等即“已发布的 bank 还在被 M1 占用”
     reg        ack_tgl_local_h;    // HCLK 域翻转
     reg  [1:0] ack_sync_a;         // adc_clk 域 2FF
-    wire       ack_edge_adc = ack_sync_a[1] ^ ack_sync_a[0];
+    wire       pub_pending = frame_done_tgl_adc ^ ack_sync_a[1];
+
+    // 抽取值/方式变化：当前半帧按旧设置采的，直接丢弃
+    wire decim_changed = (current_decim_val != decim_val_d) || (current_mode != decim_mode_d) ||
+                         (decim_roll_in != roll_d) || (decim_dual_in != dual_d);
+    wire trig_changed  = (trig_cfg_in != trig_cfg_d) && !decim_roll_in;   // 滚动方式不用触发，改电平不打断滚动
+
+    always @(posedge adc_clk or negedge adc_rstn) begin
+        if (!adc_rstn) begin
+            div_busy  <= 1'b1;
+            div_cnt   <= 6'd33;
+            div_rem   <= 17'd0;
+            div_quo   <= 32'd0;
+            avg_recip <= 32'd0;
+        end else if (decim_changed) begin
+            div_busy  <= 1'b1;
+            div_cnt   <= 6'd33;
+            div_rem   <= 17'd0;
+            div_quo   <= 32'd0;
+        end else if (div_busy) begin
+            div_rem <= div_ge ? (div_rem_sh - {1'b0, win_len}) : div_rem_sh[16:0];
+            div_quo <= {div_quo[30:0], div_ge};
+            div_cnt <= div_cnt - 6'd1;
+            if (div_cnt == 6'd1) begin
+                avg_recip <= {div_quo[30:0], div_ge};
+                div_busy  <= 1'b0;
+            end
+        end
+    end
 
     // ---------------------------------------------
-    // 写侧：抽取计数、写指针、满帧事件（ACK 优先于写）
+    // 写侧：抽取计数、环形写指针、触发、满帧发布/丢帧
     // ---------------------------------------------
     always @(posedge adc_clk or negedge adc_rstn) begin
         if (!adc_rstn) begin
             decim_cnt          <= 16'd0;
             wptr               <= {ADDR_W{1'b0}};
             frame_done_tgl_adc <= 1'b0;
+            wr_bank            <= 1'b0;
+            pub_bank_adc       <= 1'b0;
+            decim_val_d        <= DEFAULT_DECIM[15:0];
+            decim_mode_d       <= MODE_SAMPLE;
+            roll_d             <= 1'b0;
+            dual_d             <= 1'b0;
+            roll_cnt           <= 16'd0;
+            roll_gray          <= 16'd0;
+            trig_cfg_d         <= 28'd0;
+            trig_state         <= ST_WAIT;
+            trig_armed         <= 1'b0;
+            fill_cnt           <= 10'd0;
+            frame_start        <= 9'd0;
+            frame_hit          <= 1'b0;
+            pub_start_adc      <= 9'd0;
+            pub_hit_adc        <= 1'b0;
+            win_half           <= 1'b0;
+            run_min            <= 8'hFF;
+            run_max            <= 8'h00;
+            run_sum            <= 25'd0;
             ack_sync_a         <= 2'b00;
+            frame_samples      <= 32'd0;
+            drop_cnt_adc       <= 16'd0;
+            discard_adc        <= 32'd0;
+            drop_tgl_adc       <= 1'b0;
+            wr_s1              <= 1'b0;
+            wr_s2              <= 1'b0;
+            s1_lo              <= 8'd0;
+            s1_hi              <= 8'd0;
+            s1_sum             <= 25'd0;
+            s1_samples         <= 32'd0;
+            s2_lo              <= 8'd0;
+            s2_hi              <= 8'd0;
+            s2_samples         <= 32'd0;
+            avg_prod           <= 57'd0;
         end else begin
+            // 写入流水线推进；窗口结束时下面再置 wr_s1
+            wr_s1      <= 1'b0;
+            wr_s2      <= wr_s1;
+            s2_lo      <= s1_lo;
+            s2_hi      <= s1_hi;
+            s2_samples <= s1_samples;
+            avg_prod   <= s1_sum * avg_recip;
+
             // 同步 HCLK 域 ACK toggle
-            ack_sync_a <= {ack_sync_a[0], ack_tgl_local_h};
+            ack_sync_a   <= {ack_sync_a[0], ack_tgl_local_h};
+            decim_val_d  <= current_decim_val;
+            decim_mode_d <= current_mode;
+            roll_d       <= decim_roll_in;
+            dual_d       <= decim_dual_in;
+            trig_cfg_d   <= trig_cfg_in;
 
-            // ★ 先处理 ACK：清指针/计数，开启下一帧
-            if (ack_edge_adc) begin
+            // 未使能预览、抽取/触发设置变化或倒数未算完：指针/计数/窗口/触发清零，下次从 0 开始写
+            if (!preview_enable || decim_changed || trig_changed || div_busy) begin
                 wptr      <= {ADDR_W{1'b0}};
                 decim_cnt <= 16'd0;
+                roll_cnt  <= 16'd0;
+                roll_gray <= 16'd0;     // 多位同时变化，M1 改设置后先丢弃一次读数
+                trig_state <= st_init;
+                trig_armed <= 1'b0;
+                fill_cnt   <= 10'd0;
+                win_half  <= 1'b0;
+                run_min   <= 8'hFF;
+                run_max   <= 8'h00;
+                run_sum   <= 25'd0;
+                frame_samples <= 32'd0;
+                wr_s1     <= 1'b0;      // 在途的写入一并作废
+                wr_s2     <= 1'b0;
             end
-            // 其次处理写入（先写后判满）
-            else if (preview_enable && adc_valid) begin
-                if (decim_cnt == (current_decim_val - 1)) begin
-                    decim_cnt <= 16'd0;
-                    if (last_addr) begin
-                        // 地址 511 也被写入（wr_fire），随后翻转满帧事件
-                        frame_done_tgl_adc <= ~frame_done_tgl_adc;
-                        // 停在 511，等 ACK 清零后再置 0 开启下一帧
+            else begin
+                // 抽取与窗口统计：窗口结束的样点送入流水线
+                if (adc_valid) begin
+                    frame_samples <= frame_samples + 32'd1;
+                    // 窗口统计：窗口结束的样点已送入流水线，统计复位
+                    if (win_end) begin
+                        run_min <= 8'hFF;
+                        run_max <= 8'h00;
+                        run_sum <= 25'd0;
+                    end else begin
+                        run_min <= win_min;
+                        run_max <= win_max;
+                        run_sum <= win_sum;
+                    end
+
+                    if (decim_cnt == (current_decim_val - 1)) begin
+                        decim_cnt <= 16'd0;
+                        if (pair_mode && !win_half) begin
+                            // 成对方式：前 N 点只统计，不写
+                            win_half <= 1'b1;
+                        end else begin
+                            // 窗口结束：两拍后在 wr_s2 写入 RAM 并判触发
+                            win_half   <= 1'b0;
+                            wr_s1      <= 1'b1;
+                            s1_lo      <= (current_mode == MODE_PEAK) ? win_min : adc_data;
+                            s1_hi      <= (current_mode == MODE_PEAK) ? win_max :
+                                          decim_dual_in               ? adc_data_b : adc_data;
+                            s1_sum     <= win_sum;
+                            s1_samples <= frame_samples + 32'd1;
+                        end
                     end else begin
-                        wptr <= wptr + 1'b1;
+                        decim_cnt <= decim_cnt + 16'd1;
+                    end
+                end
+
+                // 写入（先写后判满）：窗口结束后第二拍，wr_fire 同拍写 RAM
+                if (wr_s2) begin
+                    wptr     <= wptr + wr_step[8:0];   // 环形：自然回绕
+                    roll_cnt <= roll_cnt_next;         // 与 RAM 同拍写入，同步到 HCLK 域时数据已在 RAM 中
+                    roll_gray <= roll_cnt_next ^ (roll_cnt_next >> 1);
+
+                    // 武装：触发后解除，样点越过回差门限后重新武装
+                    if (trig_cross)       trig_armed <= 1'b0;
+                    else if (trig_beyond) trig_armed <= 1'b1;
+
+                    if (frame_full) begin
+                        // 一帧写满
+                        fill_cnt <= 10'd0;
+                        // 窗口结束之后进来的样点（最多两拍）已算入新帧
+                        frame_samples <= frame_samples + {31'd0, adc_valid} - s2_samples;
+                        if (!pub_pending) begin
+                            // 上一帧已被 ACK：发布本 bank，切到另一 bank 从 0 开始写
+                            frame_done_tgl_adc <= ~frame_done_tgl_adc;
+                            pub_bank_adc       <= wr_bank;
+                            pub_start_adc      <= (trig_state == ST_POST) ? frame_start : start_now;
+                            pub_hit_adc        <= (trig_state == ST_POST) ? frame_hit   : (trig_en && trig_cross);
+                            wr_bank            <= ~wr_bank;
+                            wptr               <= {ADDR_W{1'b0}};
+                            trig_state         <= st_init;
+                        end else begin
+                            // M1 还在读另一 bank：丢弃本帧，同一 bank 接着环形写；
+                            // 刚写的就是最新的预触发数据，直接等下一次触发
+                            trig_state <= ST_WAIT;
+                            drop_cnt_adc <= drop_cnt_adc + 16'd1;
+                            discard_adc  <= discard_adc + s2_samples;   // 含窗口结束的样点
+                            drop_tgl_adc <= ~drop_tgl_adc;
+                        end
+                    end else begin
+                        case (trig_state)
+                            ST_PRE: begin
+                                if (fill_next >= {1'b0, pretrig}) begin
+                                    trig_state <= ST_WAIT;
+                                    fill_cnt   <= 10'd0;
+                                end else begin
+                                    fill_cnt   <= fill_next;
+                                end
+                            end
+                            ST_WAIT: begin
+                                if (trig_now) begin
+                                    trig_state  <= ST_POST;
+                                    fill_cnt    <= wr_step;      // 触发点本身算触发后部分
+                                    frame_start <= start_now;
+                                    frame_hit   <= trig_en && trig_cross;
+                                end else begin
+                                    fill_cnt    <= fill_next;
+                                end
+                            end
+                            default: fill_cnt <= fill_next;      // ST_POST
+                        endcase
                     end
-                end else begin
-                    decim_cnt <= decim_cnt + 16'd1;
                 end
-            end
-            // 未使能预览时保持计数器清零
-            else begin
-                decim_cnt <= 16'd0;
             end
         end
     end
 
     // ---------------------------------------------
-    // DPB 双口 RAM（A: adc_clk 写；B: HCLK 读）
+    // DPB 双口 RAM x4 字节通道（A: adc_clk 写；B: HCLK 读）
+    //   样点 i 写入通道 i[1:0] 的地址 {bank, i[8:2]}，两个 bank 共用同一组 RAM；
+    //   成对方式和双通道一次写相邻两个通道（0/1 或 2/3）；
+    //   读口四个通道同地址并行读出，一次得到 {s[4k+3], s[4k+2], s[4k+1], s[4k]}
     // ---------------------------------------------
-    wire [7:0] douta_o, doutb_o;
-
-//    pll_decim your_instance_name(
-//        .clkout0(dpb_clk), //100hz 270°
-//        .clkin(HCLK) //input clkin
-//    );
-
-    DPB_AD u_dpb (
-        .douta (douta_o),
-        .doutb (doutb_o),
-        .clka  (adc_clk),
-        .ocea  (1'b1),
-        .cea   (1'b1),
-        .reseta(~adc_rstn),        // 若 DPB 为高有效复位，这里取反；若为低有效复位，请去掉 ~
-        .wrea  (wr_fire),
-        .clkb  (HCLK),
-        .oceb  (1'b1),
-        .ceb   (1'b1),
-        .resetb(~HRESETn),         // 同上
-        .wreb  (1'b0),
-        .ada   (wptr),
-        .dina  (adc_data),
-        .adb   (analog_bram_addr),
-        .dinb  (8'h00)
-    );
-
-    assign analog_bram_dout = doutb_o;
+    reg        rd_bank_h;          // HCLK 域：M1 当前读取的 bank
+    reg  [8:0] rd_start_h;         // HCLK 域：该帧最早样点地址
+    reg        rd_hit_h;           // HCLK 域：该帧由真实边沿触发
+
+    wire [8:0] lane_wr_addr = {1'b0, wr_bank,   wptr[ADDR_W-1:2]};
+    // 滚动方式直接读正在写的 bank（滚动期间 wr_bank 不变）
+    wire       rd_bank_sel  = decim_roll_in ? wr_bank : rd_bank_h;
+    wire [8:0] lane_rd_addr = {1'b0, rd_bank_sel, analog_bram_addr};
+
+    genvar lane;
+    generate
+        for (lane = 0; lane < 4; lane = lane + 1) begin : g_lane
+            wire [7:0] douta_o, doutb_o;
+
+            DPB_AD u_dpb (
+                .douta (douta_o),
+                .doutb (doutb_o),
+                .clka  (adc_clk),
+                .ocea  (1'b1),
+                .cea   (1'b1),
+                .reseta(~adc_rstn),        // 若 DPB 为高有效复位，这里取反；若为低有效复位，请去掉 ~
+                .wrea  (wr_fire && (two_byte ? (wptr[1] == (lane >> 1)) : (wptr[1:0] == lane))),
+                .clkb  (HCLK),
+                .oceb  (1'b1),
+                .ceb   (1'b1),
+                .resetb(~HRESETn),         // 同上
+                .wreb  (1'b0),
+                .ada   (lane_wr_addr),
+                .dina  ((lane % 2) ? pair_hi : pair_lo),   // 偶通道 lo，奇通道 hi
+                .adb   (lane_rd_addr),
+                .dinb  (8'h00)
+            );
+
+            assign analog_bram_dout[lane*8 +: 8] = doutb_o;
+        end
+    endgenerate
+
+    assign analog_data_bank = rd_bank_h;
+    assign analog_trig_pos  = {rd_hit_h, rd_start_h};
+
+    // 滚动计数：格雷码 2FF 同步到 HCLK 域后转回二进制
+    reg [15:0] roll_gray_h1, roll_gray_h2;
+    always @(posedge HCLK or negedge HRESETn) begin
+      if (!HRESETn) begin
+        roll_gray_h1 <= 16'd0;
+        roll_gray_h2 <= 16'd0;
+      end else begin
+        roll_gray_h1 <= roll_gray;
+        roll_gray_h2 <= roll_gray_h1;
+      end
+    end
+
+    genvar gb;
+    generate
+        for (gb = 0; gb < 16; gb = gb + 1) begin : g_roll_bin
+            assign analog_roll_pos[gb] = ^roll_gray_h2[15:gb];
+        end
+    endgenerate
 
     // ---------------------------------------------
     // HCLK 域：满帧事件同步 → READY 粘性位
@@ -157,24 +497,40 @@ module adc_decim_dpb #(
     end
     wire frame_done_pulse_h = fd_h_d2 ^ fd_h_q;
 
-    // READY 粘性位
-    reg data_ready_raw;
-
-    // 记录上一拍地址（已废弃，但保留
-    reg [8:0] addr_d;
+    // 发布 bank 锁存：pub_bank_adc 与 frame_done_tgl_adc 同拍更新，且在下一次发布
+    // （必须先等 M1 ACK）之前保持不变，这里在满帧脉冲时采样是安全的；帧起点/HIT 同理
     always @(posedge HCLK or negedge HRESETn) begin
-      if (!HRESETn) addr_d <= 9'd0;
-      else          addr_d <= analog_bram_addr;
+      if (!HRESETn) begin
+        rd_bank_h  <= 1'b0;
+        rd_start_h <= 9'd0;
+        rd_hit_h   <= 1'b0;
+      end else if (frame_done_pulse_h) begin
+        rd_bank_h  <= pub_bank_adc;
+        rd_start_h <= pub_start_adc;
+        rd_hit_h   <= pub_hit_adc;
+      end
     end
 
-    // “见过 511”（已废弃）
-    reg seen_511;
+    // 丢帧统计同步：两次丢帧之间至少隔一整帧的写入（远长于同步延迟），
+    // toggle 翻转后计数值保持不变，在 HCLK 域看到翻转时采样是安全的
+    reg [2:0] drop_sync_h;
     always @(posedge HCLK or negedge HRESETn) begin
-      if (!HRESETn)              seen_511 <= 1'b0;
-      else if (!data_ready_raw)  seen_511 <= 1'b0;
-      else if (analog_bram_addr == 9'd511) seen_511 <= 1'b1;
+      if (!HRESETn) begin
+        drop_sync_h        <= 3'b000;
+        analog_drop_cnt    <= 16'd0;
+        analog_discard_cnt <= 32'd0;
+      end else begin
+        drop_sync_h <= {drop_sync_h[1:0], drop_tgl_adc};
+        if (drop_sync_h[2] ^ drop_sync_h[1]) begin
+          analog_drop_cnt    <= drop_cnt_adc;
+          analog_discard_cnt <= discard_adc;
+        end
+      end
     end
-    
+
+    // READY 粘性位
+    reg data_ready_raw;
+
     // 置位后一拍才允许考虑清零，避免“同拍置位又清掉”
     reg ready_armed;
     always @(posedge HCLK or negedge HRESETn) begin
@@ -190,9 +546,8 @@ module adc_decim_dpb #(
     reg [$clog2(READY_HOLD_CYC):0] ready_hold_cnt;
     wire hold_active = (ready_hold_cnt != 0);
 
-    // 待处理挂账
+    // ACK 挂账
     reg ack_pend;
-    // reg rd_pend; // 彻底移除 rd_pend
 
     // === ACK 上升沿检测（把 ACK 当作脉冲处理） ===
     reg ack_d;
@@ -209,37 +564,26 @@ module adc_decim_dpb #(
         ack_tgl_local_h  <= 1'b0;
         ready_hold_cnt   <= {($clog2(READY_HOLD_CYC)+1){1'b0}};
         ack_pend         <= 1'b0;
-        // rd_pend          <= 1'b0; // 彻底移除
       end else begin
         // 满帧 → READY 置位，并加载保持计数；清空待处理
         if (frame_done_pulse_h) begin
           data_ready_raw  <= 1'b1;
           ready_hold_cnt  <= READY_HOLD_CYC[$clog2(READY_HOLD_CYC):0];
           ack_pend        <= 1'b0;
-          // rd_pend         <= 1'b0; // 彻底移除
         end else if (hold_active) begin
           // 保持期计数
           ready_hold_cnt <= ready_hold_cnt - 1'b1;
         end
 
         // 只要本帧 READY 持续有效，就锁存“发生过的”ACK上升沿
-        if (data_ready_raw) begin
-          if (ack_rise) ack_pend <= 1'b1; // 仅上升沿有效
-          
-          // ====================== ★ 修复点 2 ======================
-          // 彻底移除 rd_pend 自动ACK机制
-          // =======================================================
-        
-        end
+        if (data_ready_raw && ack_rise)
+          ack_pend <= 1'b1; // 仅上升沿有效
 
-        // 保持期结束后，若任一待处理成立，则清 READY 并翻转 ACK toggle
-        // ====================== ★ 修复点 3 ======================
-        // ★ 修复点 ★：现在此条件将仅依赖 ack_pend
+        // 保持期结束后，若 ACK 已挂账，则清 READY 并翻转 ACK toggle
         if (ready_armed && !hold_active && data_ready_raw && ack_pend) begin
           data_ready_raw  <= 1'b0;
-          ack_tgl_local_h <= ~ack_tgl_local_h; // <--- ★★★ 已更正拼写 ★★★
+          ack_tgl_local_h <= ~ack_tgl_local_h;
           ack_pend        <= 1'b0;
-          // rd_pend         <= 1'b0; // 彻底移除
         end
       end
     end
@@ -0,0 +1,454 @@
+// ============================================================================
+// 深存储采集（DDR3）
+//  - 预览 BRAM 只有 512 字节，长记录放进以太网链路已有的 DDR3（ddr3_ctrl_2port）里：
+//    M1 先发"采集"，本模块占用 DDR 用户口，按 DEEP_DECIM 抽取后把 8 位样点
+//    两两打包成 16 位字写入 DDR（字节地址 = 样点序号，低字节为较早样点），
+//    记录长度 DEEP_LEN 个样点（64K..1M，256 的整数倍）。
+//  - 采集完成后 M1 发"视图"：从 DEEP_VIEW_START 起每 DEEP_VIEW_STEP 个样点取 1 点
+//    （取样）或每 2*STEP 个样点取一对 {min, max}（峰值），填满 512 字节视图缓存，
+//    M1 从 AHB 窗口 0x800..0x9FF 读出。改变 START/STEP 再发"视图"即可缩放/平移，不必重新采集。
+//  - DDR 读口只能从 rd_min 起顺序读，rd_min 按 ALIGN 个样点对齐，多读出的前导样点在本模块里丢弃。
+//  - 以太网正在用 DDR（eth_busy）或 DDR 未初始化时不接受采集/视图请求，直接应答并不置完成位；
+//    本模块忙时（deep_busy）由顶层挡住以太网启动。以太网之后写过 DDR，已有记录作废。
+//  - 等写 FIFO 不满、视图中等读 FIFO 非空各有超时（约 82us 没有进展）：放弃本次请求，
+//    应答但不置完成位，释放 DDR 用户口，避免 DDR 口异常时 deep_own 一直占着、以太网也起不来。
+//  - 时钟：DDR 用户口与采集在 clk（clk_50M）域。AD0/AD1 先在 adc_clk（AD_Clk，25MHz@270°）上升沿寄存，
+//    与以太网支路（ad_8bit_to_16bit）、预览支路相同，每个样点翻转一次 ad_tog；clk 域把数据和 ad_tog
+//    同拍打入，ad_tog 变化的那一拍取样点。两个时钟出自同一 PLL，这条跨域路径按同源时钟做时序分析；
+//    取样时刻由 AD_Clk 决定，不再依赖 clk 域自由翻转的相位位落在哪个 50MHz 沿上。
+//    请求从 HCLK 域以 toggle 送入，完成以 toggle 送回，M1 看到 BUSY=请求与应答不等。
+//    clk 域按电平处理请求（同步后的请求 ≠ 应答即为待处理），状态机每次回到 S_IDLE 都会接着处理，
+//    在采集/视图进行中或与另一请求同拍到达的请求不会丢，BUSY 也就不会一直挂着。
+//    配置寄存器在 M1 写请求之前已写好，请求期间不变，clk 域在收到请求时一次性锁存。
+// ============================================================================
+
+module ddr_deep_capture #(
+    parameter integer ALIGN_SAMPLES = 2048   // rd_min 对齐粒度（样点 = 字节），不小于一次突发
+)(
+    input  wire         clk,              // clk_50M，与 DDR 用户口同域
+    input  wire         rst,              // 高有效
+    input  wire         ddr_init_done,
+    input  wire         eth_busy,         // 以太网占用 DDR（HCLK 域电平，内部同步）
+
+    input  wire         adc_clk,          // AD_Clk，ADC 数据在其上升沿寄存
+    input  wire [7:0]   adc_data0,        // AD0（25MHz 数据）
+    input  wire [7:0]   adc_data1,        // AD1
+
+    // HCLK 域：寄存器与视图缓存
+    input  wire         HCLK,
+    input  wire         HRESETn,
+    input  wire         cap_pulse,        // 写 DEEP_CTRL bit0
+    input  wire         view_pulse,       // 写 DEEP_CTRL bit1
+    input  wire [1:0]   view_mode,        // DEEP_CTRL[3:2]：0=取样 1=峰值
+    input  wire         cap_ch,           // DEEP_CTRL[4]：0=AD0 1=AD1
+    input  wire [20:0]  cap_len,          // DEEP_LEN（样点数）
+    input  wire [15:0]  cap_decim,        // DEEP_DECIM（0 按 1 处理）
+    input  wire [19:0]  view_start,       // DEEP_VIEW_START（样点序号）
+    input  wire [15:0]  view_step,        // DEEP_VIEW_STEP（0 按 1 处理）
+    output wire [5:0]   deep_status,      // {ddr_ok, ovf, view_ok, view_busy, cap_ok, cap_busy}
+    input  wire [6:0]   view_addr,        // 视图缓存字地址 0..127
+    output reg  [31:0]  view_dout,        // 4 个样点（小端）
+
+    // DDR 用户口（deep_own=1 时由顶层切给本模块）
+    output reg          deep_own,
+    output wire         deep_busy,
+    output reg          ddr_wr_load,
+    output reg          ddr_rd_load,
+    output reg  [27:0]  ddr_rd_min,
+    output reg          ddr_wren,
+    output reg  [15:0]  ddr_din,
+    input  wire         ddr_wr_full,
+    output reg          ddr_rden,
+    input  wire         ddr_rd_empty,
+    input  wire [15:0]  ddr_dout
+);
+
+    // ------------------------------------------------------------------
+    // HCLK → clk：请求 toggle
+    // ------------------------------------------------------------------
+    reg cap_req_t, view_req_t;
+    always @(posedge HCLK or negedge HRESETn) begin
+        if (!HRESETn) begin
+            cap_req_t  <= 1'b0;
+            view_req_t <= 1'b0;
+        end else begin
+            if (cap_pulse)  cap_req_t  <= ~cap_req_t;
+            if (view_pulse) view_req_t <= ~view_req_t;
+        end
+    end
+
+    reg [2:0] cap_req_s, view_req_s;
+    reg [1:0] eth_busy_s;
+    always @(posedge clk or posedge rst) begin
+        if (rst) begin
+            cap_req_s  <= 3'd0;
+            view_req_s <= 3'd0;
+            eth_busy_s <= 2'd0;
+        end else begin
+            cap_req_s  <= {cap_req_s[1:0],  cap_req_t};
+            view_req_s <= {view_req_s[1:0], view_req_t};
+            eth_busy_s <= {eth_busy_s[0], eth_busy};
+        end
+    end
+    // ------------------------------------------------------------------
+    // adc_clk → clk：ADC 数据与样点 toggle
+    // ------------------------------------------------------------------
+    reg [7:0] ad0_a, ad1_a;
+    reg       ad_tog;
+    always @(posedge adc_clk or posedge rst) begin
+        if (rst) begin
+            ad0_a  <= 8'd0;
+            ad1_a  <= 8'd0;
+            ad_tog <= 1'b0;
+        end else begin
+            ad0_a  <= adc_data0;
+            ad1_a  <= adc_data1;
+            ad_tog <= ~ad_tog;
+        end
+    end
+
+    reg [7:0] ad0_c, ad1_c;
+    reg [1:0] ad_tog_s;
+    always @(posedge clk or posedge rst) begin
+        if (rst) begin
+            ad0_c    <= 8'd0;
+            ad1_c    <= 8'd0;
+            ad_tog_s <= 2'd0;
+        end else begin
+            ad0_c    <= ad0_a;
+            ad1_c    <= ad1_a;
+            ad_tog_s <= {ad_tog_s[0], ad_tog};
+        end
+    end
+    wire ad_stb = ad_tog_s[1] ^ ad_tog_s[0];   // ad0_c/ad1_c 本拍是新样点，每个 adc_clk 周期一次
+
+    // 待处理请求：电平，直到应答追上请求才清除
+    reg  cap_ack_t, view_ack_t;
+    wire cap_pend  = cap_req_s[2]  ^ cap_ack_t;
+    wire view_pend = view_req_s[2] ^ view_ack_t;
+
+    // ------------------------------------------------------------------
+    // clk 域状态机
+    // ------------------------------------------------------------------
+    localparam S_IDLE     = 4'd0;
+    localparam S_WR_CLR   = 4'd1;   // wr_load 保持 3 拍
+    localparam S_WR_WAIT  = 4'd2;   // 等 10 拍且写 FIFO 不满
+    localparam S_CAP      = 4'd3;
+    localparam S_DRAIN    = 4'd4;   // 等写 FIFO 剩余数据落入 DDR
+    localparam S_RD_CLR   = 4'd5;
+    localparam S_RD_WAIT  = 4'd6;
+    localparam S_VIEW     = 4'd7;
+
+    localparam [11:0] WAIT_TIMEOUT = 12'hFFF;   // FIFO 等待超时（clk 拍数）
+
+    reg [3:0]  state;
+    reg [11:0] wait_cnt;
+    reg        cap_req_l, view_req_l;   // 接受请求时的请求值，完成时作为应答送回
+    reg        cap_ok, view_ok, ovf;
+
+    // 锁存的配置
+    reg [20:0] len_l;
+    reg [15:0] decim_l;
+    reg        ch_l;
+    reg [1:0]  mode_l;
+    reg [15:0] step_l;
+
+    // 采集
+    reg [15:0] decim_cnt;
+    reg [20:0] cap_cnt;       // 已写入的样点数
+    reg [7:0]  lo_byte;
+
+    // 视图
+    reg [10:0] skip_cnt;      // rd_min 对齐后需丢弃的前导样点
+    reg [16:0] win_cnt;
+    reg [16:0] win_len;
+    reg [7:0]  win_min, win_max;
+    reg        rd_pend;       // 上拍已发 rden，本拍锁存 ddr_dout（与 state_ctrl 的读时序相同）
+    reg [15:0] word_l;
+    reg [1:0]  byte_left;     // word_l 中待处理的样点数
+    reg [9:0]  out_idx;       // 已写入视图的字节数
+    reg [31:0] out_sr;
+
+    // 视图缓存（clk 写，HCLK 读）
+    reg [31:0] view_mem [0:127];
+    reg        vm_we;
+    reg [6:0]  vm_waddr;
+    reg [31:0] vm_wdata;
+    always @(posedge clk) begin
+        if (vm_we) view_mem[vm_waddr] <= vm_wdata;
+    end
+    always @(posedge HCLK) begin
+        view_dout <= view_mem[view_addr];
+    end
+
+    wire [7:0] cur_byte = (byte_left == 2'd2) ? word_l[7:0] : word_l[15:8];
+    wire [7:0] cur_adc  = ch_l ? ad1_c : ad0_c;
+
+    // 视图起点按 ALIGN 对齐：字节地址 = 样点序号
+    wire [19:0] align_mask = ALIGN_SAMPLES - 1;
+
+    always @(posedge clk or posedge rst) begin
+        if (rst) begin
+            state       <= S_IDLE;
+            wait_cnt    <= 12'd0;
+            cap_ack_t   <= 1'b0;
+            view_ack_t  <= 1'b0;
+            cap_req_l   <= 1'b0;
+            view_req_l  <= 1'b0;
+            cap_ok      <= 1'b0;
+            view_ok     <= 1'b0;
+            ovf         <= 1'b0;
+            deep_own    <= 1'b0;
+            ddr_wr_load <= 1'b0;
+            ddr_rd_load <= 1'b0;
+            ddr_rd_min  <= 28'd0;
+            ddr_wren    <= 1'b0;
+            ddr_din     <= 16'd0;
+            ddr_rden    <= 1'b0;
+            len_l       <= 21'd0;
+            decim_l     <= 16'd1;
+            ch_l        <= 1'b0;
+            mode_l      <= 2'd0;
+            step_l      <= 16'd1;
+            decim_cnt   <= 16'd0;
+            cap_cnt     <= 21'd0;
+            lo_byte     <= 8'd0;
+            skip_cnt    <= 11'd0;
+            win_cnt     <= 17'd0;
+            win_len     <= 17'd1;
+            win_min     <= 8'hFF;
+            win_max     <= 8'h00;
+            rd_pend     <= 1'b0;
+            word_l      <= 16'd0;
+            byte_left   <= 2'd0;
+            out_idx     <= 10'd0;
+            out_sr      <= 32'd0;
+            vm_we       <= 1'b0;
+            vm_waddr    <= 7'd0;
+            vm_wdata    <= 32'd0;
+        end else begin
+            ddr_wren <= 1'b0;
+            ddr_rden <= 1'b0;
+            vm_we    <= 1'b0;
+            // 以太网写过 DDR，记录作废
+            if (eth_busy_s[1]) begin
+                cap_ok  <= 1'b0;
+                view_ok <= 1'b0;
+            end
+
+            case (state)
+                S_IDLE: begin
+                    deep_own <= 1'b0;
+                    if (cap_pend) begin
+                        if (!ddr_init_done || eth_busy_s[1]) begin
+                            cap_ack_t <= cap_req_s[2];   // 拒绝：应答但不置 cap_ok
+                        end else begin
+                            cap_req_l <= cap_req_s[2];
+                            len_l    <= (cap_len[20:8] == 13'd0) ? 21'd256 : {cap_len[20:8], 8'd0};
+                            decim_l  <= (cap_decim == 16'd0) ? 16'd1 : cap_decim;
+                            ch_l     <= cap_ch;
+                            cap_ok   <= 1'b0;
+                            view_ok  <= 1'b0;
+                            ovf      <= 1'b0;
+                            deep_own <= 1'b1;
+                            ddr_wr_load <= 1'b1;
+                            wait_cnt <= 12'd0;
+                            state    <= S_WR_CLR;
+                        end
+                    end else if (view_pend) begin
+                        if (!cap_ok || eth_busy_s[1]) begin
+                            view_ack_t <= view_req_s[2];
+                        end else begin
+                            view_req_l <= view_req_s[2];
+                            mode_l     <= view_mode;
+                            step_l     <= (view_step == 16'd0) ? 16'd1 : view_step;
+                            win_len    <= (view_step == 16'd0) ? 17'd2 : {view_step, 1'b0};
+                            ddr_rd_min <= {8'd0, view_start & ~align_mask};
+                            skip_cnt   <= view_start[10:0] & align_mask[10:0];
+                            view_ok    <= 1'b0;
+                            deep_own   <= 1'b1;
+                            ddr_rd_load <= 1'b1;
+                            wait_cnt   <= 12'd0;
+                            state      <= S_RD_CLR;
+                        end
+                    end
+                end
+
+                // ---------------- 采集 ----------------
+                S_WR_CLR: begin
+                    wait_cnt <= wait_cnt + 12'd1;
+                    if (wait_cnt == 12'd2) begin
+                        ddr_wr_load <= 1'b0;
+                        wait_cnt    <= 12'd0;
+                        state       <= S_WR_WAIT;
+                    end
+                end
+
+                S_WR_WAIT: begin
+                    wait_cnt <= wait_cnt + 12'd1;
+                    if (wait_cnt >= 12'd10 && !ddr_wr_full) begin
+                        decim_cnt <= 16'd0;
+                        cap_cnt   <= 21'd0;
+                        state     <= S_CAP;
+                    end else if (wait_cnt == WAIT_TIMEOUT) begin
+                        // 写 FIFO 一直满：放弃，cap_ok 保持 0
+                        cap_ack_t <= cap_req_l;
+                        state     <= S_IDLE;
+                    end
+                end
+
+                S_CAP: begin
+                    if (ad_stb) begin
+                        if (decim_cnt == decim_l - 16'd1) begin
+                            decim_cnt <= 16'd0;
+                            cap_cnt   <= cap_cnt + 21'd1;
+                            if (!cap_cnt[0]) begin
+                                lo_byte <= cur_adc;
+                            end else begin
+                                ddr_din  <= {cur_adc, lo_byte};
+                                ddr_wren <= 1'b1;
+                                if (ddr_wr_full) ovf <= 1'b1;
+                            end
+                            if (cap_cnt == len_l - 21'd1) begin
+                                wait_cnt <= 12'd0;
+                                state    <= S_DRAIN;
+                            end
+                        end else begin
+                            decim_cnt <= decim_cnt + 16'd1;
+                        end
+                    end
+                end
+
+                S_DRAIN: begin
+                    wait_cnt <= wait_cnt + 12'd1;
+                    if (wait_cnt == 12'hFFF) begin
+                        cap_ok    <= 1'b1;
+                        cap_ack_t <= cap_req_l;
+                        state     <= S_IDLE;
+                    end
+                end
+
+                // ---------------- 视图 ----------------
+                S_RD_CLR: begin
+                    wait_cnt <= wait_cnt + 12'd1;
+                    if (wait_cnt == 12'd2) begin
+                        ddr_rd_load <= 1'b0;
+                        wait_cnt    <= 12'd0;
+                        state       <= S_RD_WAIT;
+                    end
+                end
+
+                S_RD_WAIT: begin
+                    if (wait_cnt < 12'd10) wait_cnt <= wait_cnt + 12'd1;
+                    else begin
+                        rd_pend   <= 1'b0;
+                        byte_left <= 2'd0;
+                        win_cnt   <= 17'd0;
+                        win_min   <= 8'hFF;
+                        win_max   <= 8'h00;
+                        out_idx   <= 10'd0;
+                        wait_cnt  <= 12'd0;
+                        state     <= S_VIEW;
+                    end
+                end
+
+                S_VIEW: begin
+                    if (out_idx[9]) begin
+                        // 512 字节已满
+                        view_ok    <= 1'b1;
+                        view_ack_t <= view_req_l;
+                        state      <= S_IDLE;
+                    end else if (rd_pend) begin
+                        rd_pend   <= 1'b0;
+                        word_l    <= ddr_dout;
+                        byte_left <= 2'd2;
+                        wait_cnt  <= 12'd0;
+                    end else if (byte_left != 2'd0) begin
+                        byte_left <= byte_left - 2'd1;
+                        if (skip_cnt != 11'd0) begin
+                            skip_cnt <= skip_cnt - 11'd1;
+                        end else if (mode_l == 2'd1) begin
+                            // 峰值：每 2*STEP 个样点输出 {min, max}
+                            if (win_cnt == win_len - 17'd1) begin
+                                win_cnt <= 17'd0;
+                                win_min <= 8'hFF;
+                                win_max <= 8'h00;
+                                out_sr  <= {((cur_byte > win_max) ? cur_byte : win_max),
+                                            ((cur_byte < win_min) ? cur_byte : win_min),
+                                            out_sr[31:16]};
+                                out_idx <= out_idx + 10'd2;
+                                if (out_idx[1]) begin
+                                    vm_we    <= 1'b1;
+                                    vm_waddr <= out_idx[8:2];
+                                    vm_wdata <= {((cur_byte > win_max) ? cur_byte : win_max),
+                                                 ((cur_byte < win_min) ? cur_byte : win_min),
+                                                 out_sr[31:16]};
+                                end
+                            end else begin
+                                win_cnt <= win_cnt + 17'd1;
+                                if (cur_byte < win_min) win_min <= cur_byte;
+                                if (cur_byte > win_max) win_max <= cur_byte;
+                            end
+                        end else begin
+                            // 取样：每 STEP 个样点取 1 点，首点即 DEEP_VIEW_START
+                            win_cnt <= (win_cnt == {1'b0, step_l} - 17'd1) ? 17'd0 : win_cnt + 17'd1;
+                            if (win_cnt == 17'd0) begin
+                                out_sr  <= {cur_byte, out_sr[31:8]};
+                                out_idx <= out_idx + 10'd1;
+                                if (out_idx[1:0] == 2'd3) begin
+                                    vm_we    <= 1'b1;
+                                    vm_waddr <= out_idx[8:2];
+                                    vm_wdata <= {cur_byte, out_sr[31:8]};
+                                end
+                            end
+                        end
+                    end else if (!ddr_rd_empty) begin
+                        ddr_rden <= 1'b1;
+                        rd_pend  <= 1'b1;
+                    end else if (wait_cnt == WAIT_TIMEOUT) begin
+                        // 读 FIFO 一直空：放弃，view_ok 保持 0
+                        view_ack_t <= view_req_l;
+                        state      <= S_IDLE;
+                    end else begin
+                        wait_cnt <= wait_cnt + 12'd1;
+                    end
+                end
+
+                default: state <= S_IDLE;
+            endcase
+        end
+    end
+
+    assign deep_busy = deep_own;
+
+    // ------------------------------------------------------------------
+    // clk → HCLK：应答 toggle 与状态位
+    // ------------------------------------------------------------------
+    reg [1:0] cap_ack_s, view_ack_s;
+    reg [1:0] cap_ok_s, view_ok_s, ovf_s, init_s;
+    always @(posedge HCLK or negedge HRESETn) begin
+        if (!HRESETn) begin
+            cap_ack_s  <= 2'd0;
+            view_ack_s <= 2'd0;
+            cap_ok_s   <= 2'd0;
+            view_ok_s  <= 2'd0;
+            ovf_s      <= 2'd0;
+            init_s     <= 2'd0;
+        end else begin
+            cap_ack_s  <= {cap_ack_s[0],  cap_ack_t};
+            view_ack_s <= {view_ack_s[0], view_ack_t};
+            cap_ok_s   <= {cap_ok_s[0],   cap_ok};
+            view_ok_s  <= {view_ok_s[0],  view_ok};
+            ovf_s      <= {ovf_s[0],      ovf};
+            init_s     <= {init_s[0],     ddr_init_done};
+        end
+    end
+
+    wire cap_busy_h  = cap_req_t  ^ cap_ack_s[1];
+    wire view_busy_h = view_req_t ^ view_ack_s[1];
+    // 忙期间屏蔽旧的完成位，避免 M1 在请求刚发出时读到上一次的结果
+    assign deep_status = {init_s[1], ovf_s[1],
+                          view_ok_s[1] & ~view_busy_h, view_busy_h,
+                          cap_ok_s[1]  & ~cap_busy_h,  cap_busy_h};
+
+endmodule
@@ -0,0 +1,518 @@
+// ============================================================================
+// adc_decim_dpb 测试：乒乓双缓冲的帧发布、丢帧统计、32 位字读出、各抽取方式
+//  - DPB_AD 用下面的行为模型代替 (A 口写、B 口 bypass 读：地址在时钟沿打入，下一拍出数)
+//  - adc_clk 25MHz，HCLK 50MHz，两者相位错开；ADC 数据由 stim 选择：
+//      0 = 每拍 +1 (锯齿)，取样方式下相邻样点差 N，据此检查帧内顺序、字内字节通道顺序和帧间是否连续
+//      1 = 每 10 拍一个周期，第 2 拍 F0、第 7 拍 10，其余 40 (窄毛刺)
+//      2 = 40、41 交替
+//      3 = 每拍 +3 (快锯齿)，N=5 时相邻样点差 15 (模 256)
+//      4 = 常数 const_val
+//  - M1 模型：等 READY → 读 128 字 → 写 ACK，与固件的读帧流程相同；改设置前先停预览并 ACK
+//  检查项：
+//    1. M1 及时 ACK 时帧连续发布：相邻两帧的 READY 间隔正好 512*N 个 adc_clk，
+//       后一帧首样点紧接前一帧末样点 (差 N)，bank 交替，丢帧计数为 0
+//    2. M1 不 ACK：下一帧写满时丢弃，丢帧计数 +1、丢弃样点数 +512*N，
+//       已发布 bank 的内容在此期间不变；ACK 后恢复正常发布；连续丢两帧时两个计数
+//       各随丢帧 toggle 同步，分别 +2、+1024*N
+//    3. 峰值方式 (N=5，窗口 10 点)：毛刺输入下每对都是 {10, F0}，取样方式下同样的输入抓不全毛刺
+//    4. 平均方式：40/41 交替输入的均值 40.80 (Q8.8)，N=5 与 N=37 各一帧，N 变化后倒数重新计算；
+//       常数 C3、N=7 (窗口 14 点，倒数不是 2 的幂) 的均值须四舍五入回 C3.00
+//    5. 边沿触发 (电平 80、回差 10、预触发 128)：按 TRIG_POS 旋转后第 128 点是触发点
+//       (上升沿：前一点 < 80、该点 >= 80；下降沿对称)，整圈样点连续 (差 15)，HIT=1；
+//       常数输入下自动方式强制出帧且 HIT=0，普通方式两帧时间内不出帧
+//    6. 滚动方式：ROLL_POS 每个 HCLK 只增 0 或 1 (格雷码同步无跳变)，按 ROLL_POS 回看的
+//       400 个点连续 (差 N)，READY 始终不置位
+//    7. 双通道 (第二路接 ~adc_data)：奇地址 = ~偶地址，偶地址相邻差 N；设成峰值方式也按取样写
+// 仿真文件：tb/adc_decim_dpb_tb.v、acm2108/adc_decim_dpb.v，顶层 tb
+// 运行 (在 fpga/src 下)：iverilog -g2005 -s tb -o tb.vvp tb/adc_decim_dpb_tb.v acm2108/adc_decim_dpb.v && vvp tb.vvp
+// 状态：尚未在 iverilog 或 Gowin 仿真器下编译运行过，能否编译、检查项是否通过都未确认；
+//       被测 RTL 按未仿真对待，跑过之后把仿真器版本和输出记在这里
+// ============================================================================
+`timescale 1ns/1ps
+
+// DPB_AD 行为模型：512x8，两口均为 bypass 读
+module DPB_AD (
+    output reg  [7:0] douta,
+    output reg  [7:0] doutb,
+    input             clka,
+    input             ocea,
+    input             cea,
+    input             reseta,
+    input             wrea,
+    input             clkb,
+    input             oceb,
+    input             ceb,
+    input             resetb,
+    input             wreb,
+    input       [8:0] ada,
+    input       [7:0] dina,
+    input       [8:0] adb,
+    input       [7:0] dinb
+);
+    reg [7:0] mem [0:511];
+
+    always @(posedge clka) begin
+        if (reseta)
+            douta <= 8'd0;
+        else if (cea) begin
+            if (wrea) mem[ada] <= dina;
+            douta <= mem[ada];
+        end
+    end
+
+    always @(posedge clkb) begin
+        if (resetb)
+            doutb <= 8'd0;
+        else if (ceb) begin
+            if (wreb) mem[adb] <= dinb;
+            doutb <= mem[adb];
+        end
+    end
+endmodule
+
+module tb ;
+    localparam integer N         = 5;          // 抽取值
+    localparam integer FRAME_CLK = 512 * N;    // 一帧的 adc_clk 数
+    localparam integer ADC_T     = 40;         // adc_clk 周期 (ns)
+
+    reg         adc_clk, HCLK;
+    reg         adc_rstn, HRESETn;
+    reg  [7:0]  adc_data;
+    reg  [2:0]  stim;
+    reg  [15:0] sc;                 // 激励用样点计数
+    reg  [15:0] decim;
+    reg  [1:0]  mode;
+    reg  [7:0]  const_val;
+    reg  [27:0] trig;
+    reg         roll;
+    reg         dual;
+    reg         start;
+    reg         ack;
+    reg  [6:0]  bram_addr;
+    wire [31:0] bram_dout;
+    wire        ready;
+    wire        bank;
+    wire [9:0]  trig_pos;
+    wire [15:0] roll_pos;
+    wire [15:0] drop_cnt;
+    wire [31:0] discard_cnt;
+
+    adc_decim_dpb #(
+        .POINTS        (512),
+        .DEFAULT_DECIM (10000)
+    ) u_dut (
+        .adc_clk              (adc_clk),
+        .adc_rstn             (adc_rstn),
+        .adc_valid            (1'b1),
+        .adc_data             (adc_data),
+        .adc_data_b           (~adc_data),
+        .HCLK                 (HCLK),
+        .HRESETn              (HRESETn),
+        .analog_preview_start (start),
+        .analog_data_ack      (ack),
+        .analog_data_ready    (ready),
+        .analog_data_bank     (bank),
+        .decim_val_in         (decim),
+        .decim_mode_in        (mode),
+        .decim_roll_in        (roll),
+        .decim_dual_in        (dual),
+        .trig_cfg_in          (trig),
+        .analog_trig_pos      (trig_pos),
+        .analog_roll_pos      (roll_pos),
+        .analog_drop_cnt      (drop_cnt),
+        .analog_discard_cnt   (discard_cnt),
+        .analog_bram_addr     (bram_addr),
+        .analog_bram_dout     (bram_dout),
+        .eth_active           (1'b0)
+    );
+
+    // ---------------- 时钟与 ADC 数据 ----------------
+    initial begin
+        HCLK = 0;
+        forever #(10) HCLK = ~HCLK;             // 50MHz
+    end
+    initial begin
+        adc_clk = 0;
+        #(3);
+        forever #(ADC_T / 2) adc_clk = ~adc_clk; // 25MHz，与 HCLK 错开 3ns
+    end
+    always @(posedge adc_clk or negedge adc_rstn) begin
+        if (!adc_rstn) begin
+            sc       <= 16'd0;
+            adc_data <= 8'd0;
+        end else begin
+            sc <= sc + 16'd1;
+            case (stim)
+                3'd1:    adc_data <= (sc % 10 == 2) ? 8'hF0 : (sc % 10 == 7) ? 8'h10 : 8'h40;
+                3'd2:    adc_data <= {7'b0100000, sc[0]};
+                3'd3:    adc_data <= sc * 3;
+                3'd4:    adc_data <= const_val;
+                default: adc_data <= adc_data + 8'd1;
+            endcase
+        end
+    end
+
+    // ---------------- M1 模型 ----------------
+    reg  [7:0]  frame [0:511];
+    reg  [7:0]  rot   [0:511];      // 按帧起点旋转后的帧
+    reg  [7:0]  saved [0:511];
+    integer     errors;
+    integer     t_ready, t_prev;
+
+    // 读已发布 bank 的 128 个字，按小端拆成 512 个样点
+    task read_frame;
+        integer a;
+        begin
+            for (a = 0; a < 128; a = a + 1) begin
+                @(negedge HCLK) bram_addr = a;
+                @(posedge HCLK) #1;
+                frame[4*a]   = bram_dout[7:0];
+                frame[4*a+1] = bram_dout[15:8];
+                frame[4*a+2] = bram_dout[23:16];
+                frame[4*a+3] = bram_dout[31:24];
+            end
+        end
+    endtask
+
+    // 等下一帧 READY (上一帧已 ACK 清掉 READY)，记下 READY 置位的时刻并读出
+    task get_frame;
+        begin
+            wait (!ready);
+            wait (ready);
+            t_prev  = t_ready;
+            t_ready = $time;
+            read_frame;
+        end
+    endtask
+
+    task ack_frame;
+        begin
+            @(negedge HCLK) ack = 1'b1;
+            @(negedge HCLK) ack = 1'b0;
+        end
+    endtask
+
+    // 停预览、交还已发布的帧，再按新设置重新开始 (固件改抽取设置时同样先停 START)
+    task restart;
+        input [2:0]  new_stim;
+        input [15:0] new_decim;
+        input [1:0]  new_mode;
+        begin
+            start = 1'b0;
+            #(ADC_T * 20);
+            if (ready) begin
+                ack_frame;
+                wait (!ready);
+            end
+            stim  = new_stim;
+            decim = new_decim;
+            mode  = new_mode;
+            #(ADC_T * 10);
+            start = 1'b1;
+        end
+    endtask
+
+    // 成对方式：每对 {frame[2k], frame[2k+1]} 都应为 {lo, hi}
+    task check_pairs;
+        input [8*16-1:0] what;
+        input [7:0] lo, hi;
+        integer i, bad;
+        begin
+            bad = 0;
+            for (i = 0; i < 512; i = i + 2)
+                if (frame[i] !== lo || frame[i+1] !== hi) bad = bad + 1;
+            if (bad != 0) begin
+                $display("  %0s: %0d of 256 pairs differ from {%h, %h} (pair 0 = {%h, %h})",
+                         what, bad, lo, hi, frame[0], frame[1]);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    // 帧内相邻样点差 N (字内字节通道顺序、字间顺序)
+    task check_ramp;
+        input [8*16-1:0] what;
+        integer i, bad;
+        begin
+            bad = 0;
+            for (i = 0; i < 511; i = i + 1)
+                if (frame[i+1] !== frame[i] + N[7:0]) bad = bad + 1;
+            if (bad != 0) begin
+                $display("  %0s: %0d samples out of order (frame[0..3] = %h %h %h %h)",
+                         what, bad, frame[0], frame[1], frame[2], frame[3]);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    // 触发帧：按 TRIG_POS 的帧起点旋转，检查第 pre 点为触发点、整圈样点连续 (差 d)
+    task check_trig;
+        input [8*16-1:0] what;
+        input            falling;
+        input [9:0]      pre;
+        input [7:0]      d;
+        integer i, bad;
+        begin
+            for (i = 0; i < 512; i = i + 1)
+                rot[i] = frame[(trig_pos[8:0] + i) % 512];
+            if (!trig_pos[9]) begin
+                $display("  %0s: HIT not set", what);
+                errors = errors + 1;
+            end
+            if (falling ? !(rot[pre-1] > 8'h80 && rot[pre] <= 8'h80)
+                        : !(rot[pre-1] < 8'h80 && rot[pre] >= 8'h80)) begin
+                $display("  %0s: samples around the trigger point are %h %h (start %0d)",
+                         what, rot[pre-1], rot[pre], trig_pos[8:0]);
+                errors = errors + 1;
+            end
+            bad = 0;
+            for (i = 0; i < 511; i = i + 1)
+                if (rot[i+1] !== rot[i] + d) bad = bad + 1;
+            if (bad != 0) begin
+                $display("  %0s: %0d gaps in the rotated ring", what, bad);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    // 滚动计数监视：每个 HCLK 最多加 1
+    reg        roll_mon;
+    reg [15:0] roll_pos_d;
+    integer    roll_jumps, roll_steps;
+    always @(posedge HCLK) begin
+        if (roll_mon) begin
+            if (roll_pos != roll_pos_d && roll_pos != roll_pos_d + 16'd1) begin
+                roll_jumps = roll_jumps + 1;
+                $display("  roll: ROLL_POS jumped %h -> %h", roll_pos_d, roll_pos);
+            end
+            if (roll_pos != roll_pos_d) roll_steps = roll_steps + 1;
+            if (ready) begin
+                $display("  roll: READY set in roll mode");
+                errors = errors + 1;
+                roll_mon = 1'b0;
+            end
+        end
+        roll_pos_d <= roll_pos;
+    end
+
+    integer k, i, bad;
+    integer p;
+    integer last_bank;
+    reg [7:0] last_sample;
+    reg [15:0] drop0;
+    reg [31:0] discard0;
+
+    initial begin
+        adc_rstn  = 0;
+        HRESETn   = 0;
+        start     = 0;
+        ack       = 0;
+        bram_addr = 0;
+        stim      = 0;
+        decim     = N;
+        mode      = 0;
+        const_val = 0;
+        trig      = 0;
+        roll      = 0;
+        dual      = 0;
+        roll_mon  = 0;
+        roll_jumps = 0;
+        roll_steps = 0;
+        errors    = 0;
+        t_ready   = 0;
+        t_prev    = 0;
+        #(200);
+        adc_rstn = 1;
+        HRESETn  = 1;
+        #(200);
+        start = 1;
+
+        // ---- 1. 连续发布 ----
+        get_frame;
+        check_ramp("frame 0");
+        last_sample = frame[511];
+        last_bank   = bank;
+        ack_frame;
+        for (k = 1; k <= 4; k = k + 1) begin
+            get_frame;
+            check_ramp("back-to-back");
+            if (t_ready - t_prev != FRAME_CLK * ADC_T) begin
+                $display("  frame %0d: READY %0d ns after the previous one, expect %0d",
+                         k, t_ready - t_prev, FRAME_CLK * ADC_T);
+                errors = errors + 1;
+            end
+            if (frame[0] !== last_sample + N[7:0]) begin
+                $display("  frame %0d: first sample %h after last sample %h (gap across the bank swap)",
+                         k, frame[0], last_sample);
+                errors = errors + 1;
+            end
+            if (bank == last_bank) begin
+                $display("  frame %0d: bank %0d published twice in a row", k, bank);
+                errors = errors + 1;
+            end
+            last_sample = frame[511];
+            last_bank   = bank;
+            ack_frame;
+        end
+        if (drop_cnt != 16'd0) begin
+            $display("  %0d frames dropped with prompt ACKs", drop_cnt);
+            errors = errors + 1;
+        end
+        $display("back-to-back frames: 5 frames, READY every %0d adc_clk, drops %0d",
+                 (t_ready - t_prev) / ADC_T, drop_cnt);
+
+        // ---- 2. 不 ACK：丢帧 ----
+        get_frame;
+        for (i = 0; i < 512; i = i + 1) saved[i] = frame[i];
+        drop0    = drop_cnt;
+        discard0 = discard_cnt;
+        #(FRAME_CLK * ADC_T * 3 / 2);           // 下一帧已写满并丢弃，再下一帧未满
+        if (drop_cnt != drop0 + 16'd1) begin
+            $display("  drop counter %0d -> %0d, expect +1", drop0, drop_cnt);
+            errors = errors + 1;
+        end
+        if (discard_cnt != discard0 + FRAME_CLK) begin
+            $display("  discard counter %0d -> %0d, expect +%0d", discard0, discard_cnt, FRAME_CLK);
+            errors = errors + 1;
+        end
+        if (!ready) begin
+            $display("  READY dropped without an ACK");
+            errors = errors + 1;
+        end
+        read_frame;
+        bad = 0;
+        for (i = 0; i < 512; i = i + 1)
+            if (frame[i] !== saved[i]) bad = bad + 1;
+        if (bad != 0) begin
+            $display("  %0d samples of the published bank changed while it was held", bad);
+            errors = errors + 1;
+        end
+        ack_frame;
+        get_frame;
+        check_ramp("after drop");
+        $display("unacknowledged frame: drops %0d -> %0d, discarded samples %0d -> %0d",
+                 drop0, drop_cnt, discard0, discard_cnt);
+        drop0    = drop_cnt;
+        discard0 = discard_cnt;
+        #(FRAME_CLK * ADC_T * 5 / 2);           // 连续两帧写满并丢弃
+        if (drop_cnt != drop0 + 16'd2 || discard_cnt != discard0 + 2 * FRAME_CLK) begin
+            $display("  two drops: counters %0d/%0d -> %0d/%0d, expect +2/+%0d",
+                     drop0, discard0, drop_cnt, discard_cnt, 2 * FRAME_CLK);
+            errors = errors + 1;
+        end
+        ack_frame;
+        get_frame;
+        check_ramp("after two drops");
+        ack_frame;
+
+        // ---- 3. 峰值方式 ----
+        restart(3'd1, N, 2'd1);
+        get_frame;
+        check_pairs("peak", 8'h10, 8'hF0);
+        ack_frame;
+        get_frame;
+        check_pairs("peak, 2nd frame", 8'h10, 8'hF0);
+        ack_frame;
+        restart(3'd1, N, 2'd0);
+        get_frame;
+        ack_frame;
+        bad = 0;
+        for (i = 0; i < 512; i = i + 1)
+            if (frame[i] == 8'hF0 || frame[i] == 8'h10) bad = bad + 1;
+        $display("peak mode: 2 frames of {min, max} pairs checked; sample mode kept %0d of 512 glitch samples", bad);
+
+        // ---- 4. 平均方式 ----
+        restart(3'd2, N, 2'd2);
+        get_frame;
+        check_pairs("average N=5", 8'h80, 8'h40);
+        ack_frame;
+        restart(3'd2, 16'd37, 2'd2);
+        get_frame;
+        check_pairs("average N=37", 8'h80, 8'h40);
+        ack_frame;
+        const_val = 8'hC3;
+        restart(3'd4, 16'd7, 2'd2);
+        get_frame;
+        check_pairs("average N=7", 8'h00, 8'hC3);
+        ack_frame;
+        $display("average mode: 40/41 -> 40.80 at N=5 and N=37, constant C3 -> C3.00 at N=7");
+
+        // ---- 5. 边沿触发 ----
+        // trig: [7:0] 电平 80，[15:8] 回差 10，[24:16] 预触发 128，[25] 斜率，[26] 使能，[27] 自动
+        trig = 28'h4801080;
+        restart(3'd3, N, 2'd0);
+        get_frame;
+        check_trig("rising", 1'b0, 128, 8'd15);
+        ack_frame;
+        get_frame;
+        check_trig("rising, 2nd", 1'b0, 128, 8'd15);
+        ack_frame;
+        trig = 28'h6801080;
+        restart(3'd3, N, 2'd0);
+        get_frame;
+        check_trig("falling", 1'b1, 128, 8'd15);
+        ack_frame;
+        const_val = 8'h55;
+        trig = 28'hC801080;
+        restart(3'd4, N, 2'd0);
+        get_frame;
+        if (trig_pos[9]) begin
+            $display("  auto: HIT set on a constant input");
+            errors = errors + 1;
+        end
+        ack_frame;
+        trig = 28'h4801080;
+        restart(3'd4, N, 2'd0);
+        #(FRAME_CLK * ADC_T * 2);
+        if (ready) begin
+            $display("  normal: frame published without a trigger");
+            errors = errors + 1;
+        end
+        $display("edge trigger: rising/falling trigger point at rotated index 128, auto HIT=0, normal mode waits");
+
+        // ---- 6. 滚动方式 ----
+        trig = 28'd0;
+        roll = 1'b1;
+        restart(3'd0, N, 2'd0);
+        @(posedge HCLK);
+        roll_mon = 1'b1;
+        #(FRAME_CLK * ADC_T * 2);
+        @(posedge HCLK) #1;
+        p = roll_pos;
+        read_frame;
+        roll_mon = 1'b0;
+        bad = 0;
+        for (i = 0; i < 399; i = i + 1)
+            if (frame[(p + 1023 - i) % 512] !== frame[(p + 1022 - i) % 512] + N[7:0]) bad = bad + 1;
+        if (bad != 0) begin
+            $display("  roll: %0d gaps in the 400 points behind ROLL_POS %0d", bad, p);
+            errors = errors + 1;
+        end
+        if (roll_jumps != 0) errors = errors + 1;
+        $display("roll mode: ROLL_POS %0d after 2 frame times, %0d HCLK steps, %0d jumps",
+                 p, roll_steps, roll_jumps);
+        roll = 1'b0;
+
+        // ---- 7. 双通道 ----
+        dual = 1'b1;
+        restart(3'd0, N, 2'd1);
+        get_frame;
+        ack_frame;
+        bad = 0;
+        for (i = 0; i < 512; i = i + 2) begin
+            if (frame[i+1] !== ~frame[i]) bad = bad + 1;
+            if (i < 510 && frame[i+2] !== frame[i] + N[7:0]) bad = bad + 1;
+        end
+        if (bad != 0) begin
+            $display("  dual: %0d mismatches (pair 0 = {%h, %h}, pair 1 = {%h, %h})",
+                     bad, frame[0], frame[1], frame[2], frame[3]);
+            errors = errors + 1;
+        end
+        $display("dual channel: 256 {a, b} pairs checked at step %0d with the peak setting on", N);
+        dual = 1'b0;
+
+        if (errors == 0) $display("adc_decim_dpb checks: OK");
+        else             $display("adc_decim_dpb checks: FAILED (%0d)", errors);
+        $finish;
+    end
+endmodule
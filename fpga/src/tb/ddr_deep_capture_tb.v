@@ -0,0 +1,391 @@
+// ============================================================================
+// ddr_deep_capture 测试：采集写 DDR、取样/峰值视图、请求拒绝与 FIFO 等待超时
+//  - DDR 用户口用下面的行为模型代替 (ddr3_ctrl_2port 不在工程里)：
+//      写口：wr_load 后写指针回 0，写 FIFO 满若干拍；每拍 wren 写一个 16 位字
+//      读口：rd_load 后读指针 = rd_min/2 (字节地址 → 16 位字)，过若干拍后读 FIFO 非空；
+//            show-ahead 方式，dout 为队首，rden 弹出 (与 state_ctrl 在 rden 同拍取 dout 相同)
+//      stall_wr/stall_rd 置 1 时写 FIFO 一直满 / 读 FIFO 一直空，模拟 DDR 口卡死
+//  - clk 与 HCLK 同为 50MHz、相位错开；adc_clk 25MHz，上升沿落在 clk 两个上升沿之间 (同源、相位错开)
+//  - ADC 模型：adc_clk 上升沿后 2ns 输出变为 X，17ns 后稳定为新值 (AD0 加 1 的锯齿，AD1 = AD0*3)；
+//    X 窗口盖住其中一个 clk 上升沿，直接在 clk 域按自由相位取 AD0/AD1 会有一半机会采到 X
+//  检查项：
+//    1. 未采集时请求视图被拒绝 (BUSY 回 0，VIEW_OK=0)
+//    2. AD1、抽取 3 采集 4096 点：DDR 里相邻样点差 9；AD0、抽取 1：相邻样点差 1，CAP_OK=1、OVF=0；
+//       两次请求错开一个 clk，任一次采到 X 窗口都会出错
+//    3. 取样视图 START=2148 (不对齐，丢弃 100 个前导样点)、STEP=1：512 字节与 DDR 里的样点一致
+//    4. 峰值视图 START=10、STEP=3：每 6 点一对 {min, max}，与 DDR 里的样点一致
+//    5. 读 FIFO 卡死时视图超时放弃：BUSY 回 0、VIEW_OK=0、deep_busy 释放；恢复后视图正常
+//    6. 写 FIFO 卡死时采集超时放弃：CAP_OK=0、deep_busy 释放
+//    7. 以太网占用时采集请求被拒绝，不占 DDR 口
+//    8. 采集进行中发视图请求：采集完成后接着生成视图，两个 BUSY 都回 0
+//    9. 采集与视图请求同一拍写入：两个都处理，两个 BUSY 都回 0
+// 仿真文件：tb/ddr_deep_capture_tb.v、acm2108/ddr_deep_capture.v，顶层 tb
+// 运行 (在 fpga/src 下)：iverilog -g2005 -s tb -o tb.vvp tb/ddr_deep_capture_tb.v acm2108/ddr_deep_capture.v && vvp tb.vvp
+// 状态：尚未在 iverilog 或 Gowin 仿真器下编译运行过，能否编译、检查项是否通过都未确认；
+//       被测 RTL 按未仿真对待，跑过之后把仿真器版本和输出记在这里
+// ============================================================================
+`timescale 1ns/1ps
+
+module tb ;
+    reg         clk, HCLK, adc_clk;
+    reg         rst, HRESETn;
+    reg         eth_busy;
+    reg  [7:0]  adc_cnt;
+    reg         adc_x;              // ADC 输出正在变化
+    wire [7:0]  adc0 = adc_x ? 8'hxx : adc_cnt;
+    wire [7:0]  adc1 = adc_x ? 8'hxx : adc_cnt * 8'd3;
+
+    reg         cap_pulse, view_pulse;
+    reg  [1:0]  view_mode;
+    reg         cap_ch;
+    reg  [20:0] cap_len;
+    reg  [15:0] cap_decim;
+    reg  [19:0] view_start;
+    reg  [15:0] view_step;
+    wire [5:0]  status;
+    reg  [6:0]  view_addr;
+    wire [31:0] view_dout;
+
+    wire        deep_own, deep_busy;
+    wire        wr_load, rd_load, wren, rden;
+    wire [27:0] rd_min;
+    wire [15:0] din;
+    wire        wr_full, rd_empty;
+    wire [15:0] dout;
+
+    ddr_deep_capture u_dut (
+        .clk           (clk),
+        .rst           (rst),
+        .ddr_init_done (1'b1),
+        .eth_busy      (eth_busy),
+        .adc_clk       (adc_clk),
+        .adc_data0     (adc0),
+        .adc_data1     (adc1),
+        .HCLK          (HCLK),
+        .HRESETn       (HRESETn),
+        .cap_pulse     (cap_pulse),
+        .view_pulse    (view_pulse),
+        .view_mode     (view_mode),
+        .cap_ch        (cap_ch),
+        .cap_len       (cap_len),
+        .cap_decim     (cap_decim),
+        .view_start    (view_start),
+        .view_step     (view_step),
+        .deep_status   (status),
+        .view_addr     (view_addr),
+        .view_dout     (view_dout),
+        .deep_own      (deep_own),
+        .deep_busy     (deep_busy),
+        .ddr_wr_load   (wr_load),
+        .ddr_rd_load   (rd_load),
+        .ddr_rd_min    (rd_min),
+        .ddr_wren      (wren),
+        .ddr_din       (din),
+        .ddr_wr_full   (wr_full),
+        .ddr_rden      (rden),
+        .ddr_rd_empty  (rd_empty),
+        .ddr_dout      (dout)
+    );
+
+    // ---------------- DDR 用户口模型 ----------------
+    reg  [15:0] mem [0:65535];
+    reg  [15:0] wptr, rptr;
+    reg  [7:0]  wr_busy_cnt, rd_busy_cnt;
+    reg         stall_wr, stall_rd;
+
+    assign wr_full  = stall_wr || (wr_busy_cnt != 8'd0);
+    assign rd_empty = stall_rd || (rd_busy_cnt != 8'd0);
+    assign dout     = mem[rptr];
+
+    always @(posedge clk) begin
+        if (wr_load) begin
+            wptr        <= 16'd0;
+            wr_busy_cnt <= 8'd5;
+        end else begin
+            if (wr_busy_cnt != 8'd0) wr_busy_cnt <= wr_busy_cnt - 8'd1;
+            if (wren) begin
+                mem[wptr] <= din;
+                wptr      <= wptr + 16'd1;
+            end
+        end
+        if (rd_load) begin
+            rptr        <= rd_min[16:1];
+            rd_busy_cnt <= 8'd20;
+        end else begin
+            if (rd_busy_cnt != 8'd0) rd_busy_cnt <= rd_busy_cnt - 8'd1;
+            if (rden) rptr <= rptr + 16'd1;
+        end
+    end
+
+    // 样点序号 → DDR 里的字节
+    function [7:0] ddr_byte;
+        input [19:0] i;
+        reg   [15:0] w;
+        begin
+            w        = mem[i[16:1]];
+            ddr_byte = i[0] ? w[15:8] : w[7:0];
+        end
+    endfunction
+
+    // ---------------- 时钟与 ADC ----------------
+    initial begin
+        clk = 0;
+        forever #(10) clk = ~clk;
+    end
+    initial begin
+        HCLK = 0;
+        #(7);
+        forever #(10) HCLK = ~HCLK;
+    end
+    initial begin
+        adc_clk = 0;
+        #(5);
+        forever #(20) adc_clk = ~adc_clk;
+    end
+    initial begin
+        adc_cnt = 8'd0;
+        adc_x   = 1'b0;
+    end
+    always @(posedge adc_clk) begin
+        #(2)  adc_x   = 1'b1;
+        #(15) adc_cnt = adc_cnt + 8'd1;
+              adc_x   = 1'b0;
+    end
+
+    // ---------------- M1 模型 ----------------
+    integer errors;
+    reg     own_seen;           // 本次请求期间 deep_own 是否置过位
+    always @(posedge clk) if (deep_own) own_seen <= 1'b1;
+
+    reg [7:0] vbuf [0:511];
+    integer   t0;
+
+    // deep_status: [0] cap_busy [1] cap_ok [2] view_busy [3] view_ok [4] ovf [5] ddr_ok
+    task capture;
+        input        ch;
+        input [15:0] decim;
+        input [20:0] len;
+        begin
+            @(negedge HCLK);
+            cap_ch    = ch;
+            cap_decim = decim;
+            cap_len   = len;
+            own_seen  = 1'b0;
+            cap_pulse = 1'b1;
+            @(negedge HCLK) cap_pulse = 1'b0;
+            t0 = $time;
+            wait (!status[0]);
+            @(negedge HCLK);
+            @(negedge HCLK);
+        end
+    endtask
+
+    task view;
+        input [1:0]  mode;
+        input [19:0] start;
+        input [15:0] step;
+        begin
+            @(negedge HCLK);
+            view_mode  = mode;
+            view_start = start;
+            view_step  = step;
+            own_seen   = 1'b0;
+            view_pulse = 1'b1;
+            @(negedge HCLK) view_pulse = 1'b0;
+            t0 = $time;
+            wait (!status[2]);
+            @(negedge HCLK);
+            @(negedge HCLK);
+        end
+    endtask
+
+    task read_view;
+        integer a;
+        begin
+            for (a = 0; a < 128; a = a + 1) begin
+                @(negedge HCLK) view_addr = a;
+                @(posedge HCLK) #1;
+                vbuf[4*a]   = view_dout[7:0];
+                vbuf[4*a+1] = view_dout[15:8];
+                vbuf[4*a+2] = view_dout[23:16];
+                vbuf[4*a+3] = view_dout[31:24];
+            end
+        end
+    endtask
+
+    task check_bit;
+        input [8*28-1:0] what;
+        input            got, want;
+        begin
+            if (got !== want) begin
+                $display("  %0s: got %b, expect %b", what, got, want);
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    // DDR 里前 n 个样点相邻差 d
+    task check_record;
+        input [8*16-1:0] what;
+        input [20:0]     n;
+        input [7:0]      d;
+        integer i, bad;
+        begin
+            bad = 0;
+            for (i = 0; i < n - 1; i = i + 1)
+                if (ddr_byte(i + 1) !== ddr_byte(i) + d) bad = bad + 1;
+            if (bad != 0) begin
+                $display("  %0s: %0d of %0d samples out of step (s0..s3 = %h %h %h %h)",
+                         what, bad, n, ddr_byte(0), ddr_byte(1), ddr_byte(2), ddr_byte(3));
+                errors = errors + 1;
+            end
+        end
+    endtask
+
+    // 等两个 BUSY 都回 0，超过 limit 个 HCLK 周期算请求丢失
+    task wait_idle;
+        input [8*28-1:0] what;
+        input [31:0]     limit;
+        integer n;
+        begin
+            n = 0;
+            while ((status[0] || status[2]) && n < limit) begin
+                @(negedge HCLK);
+                n = n + 1;
+            end
+            if (status[0] || status[2]) begin
+                $display("  %0s: BUSY stuck (status %b)", what, status);
+                errors = errors + 1;
+            end
+            @(negedge HCLK);
+            @(negedge HCLK);
+        end
+    endtask
+
+    integer i, j, bad;
+    reg [7:0] mn, mx, b;
+
+    initial begin
+        rst = 1; HRESETn = 0; eth_busy = 0;
+        cap_pulse = 0; view_pulse = 0; view_mode = 0; cap_ch = 0;
+        cap_len = 0; cap_decim = 0; view_start = 0; view_step = 0; view_addr = 0;
+        stall_wr = 0; stall_rd = 0;
+        wptr = 0; rptr = 0; wr_busy_cnt = 0; rd_busy_cnt = 0;
+        own_seen = 0;
+        errors = 0;
+        #(200);
+        rst = 0; HRESETn = 1;
+        #(200);
+
+        // ---- 1. 未采集时视图被拒绝 ----
+        view(2'd0, 20'd0, 16'd1);
+        check_bit("view before capture: VIEW_OK", status[3], 1'b0);
+        check_bit("view before capture: own", own_seen, 1'b0);
+
+        // ---- 2. 采集 ----
+        capture(1'b1, 16'd3, 21'd4096);
+        check_bit("capture AD1/3: CAP_OK", status[1], 1'b1);
+        check_record("AD1, decim 3", 21'd4096, 8'd9);
+        @(negedge HCLK);                // 错开一个 clk：两次采集从 adc_clk 的不同相位开始
+        capture(1'b0, 16'd1, 21'd4096);
+        check_bit("capture AD0/1: CAP_OK", status[1], 1'b1);
+        check_bit("capture AD0/1: OVF", status[4], 1'b0);
+        check_record("AD0, decim 1", 21'd4096, 8'd1);
+        $display("capture: 4096 samples in %0d ns, written words %0d, CAP_OK %b OVF %b",
+                 $time - t0, wptr, status[1], status[4]);
+
+        // ---- 3. 取样视图 ----
+        view(2'd0, 20'd2148, 16'd1);
+        check_bit("sample view: VIEW_OK", status[3], 1'b1);
+        read_view;
+        bad = 0;
+        for (i = 0; i < 512; i = i + 1)
+            if (vbuf[i] !== ddr_byte(2148 + i)) bad = bad + 1;
+        if (bad != 0) begin
+            $display("  sample view: %0d of 512 bytes differ (v0 = %h, s2148 = %h)",
+                     bad, vbuf[0], ddr_byte(2148));
+            errors = errors + 1;
+        end
+        $display("sample view: start 2148 (rd_min %0d), %0d ns, %0d mismatches",
+                 rd_min, $time - t0, bad);
+
+        // ---- 4. 峰值视图 ----
+        view(2'd1, 20'd10, 16'd3);
+        check_bit("peak view: VIEW_OK", status[3], 1'b1);
+        read_view;
+        bad = 0;
+        for (i = 0; i < 256; i = i + 1) begin
+            mn = 8'hFF;
+            mx = 8'h00;
+            for (j = 0; j < 6; j = j + 1) begin
+                b = ddr_byte(10 + 6 * i + j);
+                if (b < mn) mn = b;
+                if (b > mx) mx = b;
+            end
+            if (vbuf[2*i] !== mn || vbuf[2*i+1] !== mx) bad = bad + 1;
+        end
+        if (bad != 0) begin
+            $display("  peak view: %0d of 256 pairs differ (pair 0 = {%h, %h})", bad, vbuf[0], vbuf[1]);
+            errors = errors + 1;
+        end
+        $display("peak view: start 10 step 3, %0d mismatched pairs", bad);
+
+        // ---- 5. 读 FIFO 卡死：视图超时 ----
+        stall_rd = 1'b1;
+        view(2'd0, 20'd0, 16'd1);
+        check_bit("stalled view: VIEW_OK", status[3], 1'b0);
+        check_bit("stalled view: deep_busy", deep_busy, 1'b0);
+        check_bit("stalled view: own taken", own_seen, 1'b1);
+        $display("stalled view: gave up after %0d ns, VIEW_OK %b, deep_busy %b", $time - t0, status[3], deep_busy);
+        stall_rd = 1'b0;
+        view(2'd0, 20'd0, 16'd1);
+        check_bit("view after stall: VIEW_OK", status[3], 1'b1);
+        check_bit("view after stall: CAP_OK", status[1], 1'b1);
+
+        // ---- 6. 写 FIFO 卡死：采集超时 ----
+        stall_wr = 1'b1;
+        capture(1'b0, 16'd1, 21'd4096);
+        check_bit("stalled capture: CAP_OK", status[1], 1'b0);
+        check_bit("stalled capture: deep_busy", deep_busy, 1'b0);
+        $display("stalled capture: gave up after %0d ns, CAP_OK %b, deep_busy %b", $time - t0, status[1], deep_busy);
+        stall_wr = 1'b0;
+
+        // ---- 7. 以太网占用 ----
+        capture(1'b0, 16'd1, 21'd4096);
+        eth_busy = 1'b1;
+        #(200);
+        capture(1'b0, 16'd1, 21'd4096);
+        check_bit("capture during eth: CAP_OK", status[1], 1'b0);
+        check_bit("capture during eth: own", own_seen, 1'b0);
+        eth_busy = 1'b0;
+
+        // ---- 8. 采集进行中请求视图 ----
+        @(negedge HCLK);
+        cap_ch = 1'b0; cap_decim = 16'd1; cap_len = 21'd4096;
+        view_mode = 2'd0; view_start = 20'd0; view_step = 16'd1;
+        cap_pulse = 1'b1;
+        @(negedge HCLK) cap_pulse = 1'b0;
+        t0 = $time;
+        repeat (200) @(negedge HCLK);
+        check_bit("view during capture: own", deep_own, 1'b1);
+        view_pulse = 1'b1;
+        @(negedge HCLK) view_pulse = 1'b0;
+        wait_idle("view during capture", 100000);
+        check_bit("view during capture: CAP_OK", status[1], 1'b1);
+        check_bit("view during capture: VIEW_OK", status[3], 1'b1);
+        $display("view during capture: both done after %0d ns, status %b", $time - t0, status);
+
+        // ---- 9. 采集与视图同拍 ----
+        @(negedge HCLK);
+        cap_pulse = 1'b1; view_pulse = 1'b1;
+        @(negedge HCLK) begin cap_pulse = 1'b0; view_pulse = 1'b0; end
+        wait_idle("capture + view same cycle", 100000);
+        check_bit("capture + view same cycle: CAP_OK", status[1], 1'b1);
+        check_bit("capture + view same cycle: VIEW_OK", status[3], 1'b1);
+        check_record("AD0 after same-cycle", 21'd4096, 8'd1);
+
+        if (errors == 0) $display("ddr_deep_capture checks: OK");
+        else             $display("ddr_deep_capture checks: FAILED (%0d)", errors);
+        $finish;
+    end
+endmodule
@@ -33,6 +33,10 @@ module M1SC_MCU_LCD(
     // UART 调试输出引脚
     output        uart_debug_tx_pin,
 
+    // M1 UART0 (printf / 性能统计导出)
+    output        m1_uart_tx,
+    input         m1_uart_rx,
+
     // 数字信号输入的物理引脚
     input         digital_signal_in,
 
@@ -158,10 +162,25 @@ wire HCLK_out = HCLK;
     wire        uart_tx_debug_wire;
     
     // --- 连接 Analog Preview Test 模块的信号线 ---
-    wire [8:0]  analog_bram_addr_wire;
-    wire [7:0]  analog_bram_dout_wire;
+    wire [6:0]  analog_bram_addr_wire;
+    wire [31:0] analog_bram_dout_wire;
     wire        analog_data_ready_wire;
-    wire [15:0] decim_control_wire;  //新增的时基调节连接线
+    wire        analog_data_bank_wire;   // 乒乓缓冲当前可读 bank
+    wire        fpga_irq_wire;           // AHB2 数据就绪中断 → M1 EXTINT[0]
+    wire [19:0] decim_control_wire;  //新增的时基调节连接线（[17:16] 抽取方式，[18] 滚动，[19] 双通道）
+    wire [27:0] trig_control_wire;       // 预览触发配置（ANALOG_TRIG_REG）
+    wire [9:0]  analog_trig_pos_wire;    // 已发布帧的起点地址与 HIT（ANALOG_TRIG_POS）
+    wire [15:0] analog_roll_pos_wire;    // 滚动方式已写入的点数（ANALOG_ROLL_POS）
+    wire [15:0] analog_drop_cnt_wire;    // 统计：丢弃的帧数
+    wire [31:0] analog_discard_cnt_wire; // 统计：丢弃帧里的 ADC 样点数
+    wire [4:0]  deep_ctrl_wire;          // 深存储控制（DEEP_CTRL）
+    wire [20:0] deep_len_wire;           // 深存储记录长度（DEEP_LEN）
+    wire [15:0] deep_decim_wire;         // 深存储采集抽取值（DEEP_DECIM）
+    wire [19:0] deep_view_start_wire;    // 深存储视图起点（DEEP_VIEW_START）
+    wire [15:0] deep_view_step_wire;     // 深存储视图步长（DEEP_VIEW_STEP）
+    wire [5:0]  deep_status_wire;        // 深存储状态（DEEP_STATUS）
+    wire [6:0]  deep_view_addr_wire;
+    wire [31:0] deep_view_dout_wire;
 
       // --- 数字输入链路的信号线 ---
     //wire        test_signal_out_wire;
@@ -191,9 +210,10 @@ wire HCLK_out = HCLK;
         .GPIO          (GPIO),
         .JTAG_7        (SWDIO),
         .JTAG_9        (SWCLK),
-        .UART0RXD      (1'b0),
-        .UART0TXD      (),
+        .UART0RXD      (m1_uart_rx),
+        .UART0TXD      (m1_uart_tx),
         .TIMER0EXTIN   (1'b0),
+        .EXTINT        ({3'b000, fpga_irq_wire}), // 需在 EMPU IP 中使能外部中断
         .AHB1HRDATA    (AHB1HRDATA),
         .AHB1HREADYOUT (AHB1HREADYOUT),
         .AHB1HRESP     (AHB1HRESP),
@@ -283,10 +303,24 @@ wire HCLK_out = HCLK;
         .MODE_DDS             (mode_dds_wire),
         .analog_preview_start (analog_preview_start_wire),
         .analog_data_ready    (analog_data_ready_wire),
+        .analog_data_bank     (analog_data_bank_wire),
         .analog_data_ack      (analog_data_ack_wire),
         .analog_bram_dout     (analog_bram_dout_wire),
         .analog_bram_addr     (analog_bram_addr_wire),
         .analog_decim_val     (decim_control_wire),   //新增的时基调节端口
+        .analog_trig_cfg      (trig_control_wire),
+        .analog_trig_pos      (analog_trig_pos_wire),
+        .analog_roll_pos      (analog_roll_pos_wire),
+        .analog_drop_cnt      (analog_drop_cnt_wire),
+        .analog_discard_cnt   (analog_discard_cnt_wire),
+        .deep_ctrl            (deep_ctrl_wire),
+        .deep_len             (deep_len_wire),
+        .deep_decim           (deep_decim_wire),
+        .deep_view_start      (deep_view_start_wire),
+        .deep_view_step       (deep_view_step_wire),
+        .deep_status          (deep_status_wire),
+        .deep_view_addr       (deep_view_addr_wire),
+        .deep_view_dout       (deep_view_dout_wire),
         .digital_meas_start   (digital_meas_start_wire),
         .digital_meas_ack     (digital_meas_ack_wire),
         .digital_meas_ready   (digital_meas_ready_wire),
@@ -299,6 +333,7 @@ wire HCLK_out = HCLK;
         .capture_bram_rdata   (capture_bram_rdata),
         .digital_in_data      (32'h0),
         .usb_cdc_start   (),
+        .fpga_irq             (fpga_irq_wire),
         .uart_tx_debug        (uart_tx_debug_wire)
     );
     
@@ -419,9 +454,23 @@ assign led[7] = 0;
   .analog_preview_start (analog_preview_start_wire),
   .analog_data_ack      (analog_data_ack_wire),
   .analog_data_ready    (analog_data_ready_wire),
+  .analog_data_bank     (analog_data_bank_wire),
   .analog_bram_addr     (analog_bram_addr_wire),
   .analog_bram_dout     (analog_bram_dout_wire),
   .decim_control_wire   (decim_control_wire),
+  .trig_control_wire    (trig_control_wire),
+  .analog_trig_pos      (analog_trig_pos_wire),
+  .analog_roll_pos      (analog_roll_pos_wire),
+  .analog_drop_cnt      (analog_drop_cnt_wire),
+  .analog_discard_cnt   (analog_discard_cnt_wire),
+  .deep_ctrl_wire       (deep_ctrl_wire),
+  .deep_len_wire        (deep_len_wire),
+  .deep_decim_wire      (deep_decim_wire),
+  .deep_view_start_wire (deep_view_start_wire),
+  .deep_view_step_wire  (deep_view_step_wire),
+  .deep_status          (deep_status_wire),
+  .deep_view_addr       (deep_view_addr_wire),
+  .deep_view_dout       (deep_view_dout_wire),
   .clk_50M  (clk_50M),
   .AD_Clk   (AD_Clk),
 